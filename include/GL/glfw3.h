@@ -144,6 +144,9 @@ extern "C" {
  #include <stddef.h>
 #endif
 
+/* The raw timer functions return 64-bit unsigned integers */
+#include <stdint.h>
+
 
 /* ---------------- GLFW related system specific defines ----------------- */
 
@@ -493,6 +496,7 @@ extern "C" {
 #define GLFW_SHOULD_CLOSE           0x00020003
 #define GLFW_RESIZABLE              0x00022007
 #define GLFW_VISIBLE                0x00022008
+#define GLFW_HEADLESS               0x00022009
 
 #define GLFW_CONTEXT_REVISION       0x00020004
 #define GLFW_RED_BITS               0x00021000
@@ -532,6 +536,8 @@ extern "C" {
 #define GLFW_CURSOR_MODE            0x00030001
 #define GLFW_STICKY_KEYS            0x00030002
 #define GLFW_STICKY_MOUSE_BUTTONS   0x00030003
+#define GLFW_COALESCE_EVENTS        0x00030004
+#define GLFW_EVENT_QUEUE            0x00030005
 
 #define GLFW_CURSOR_NORMAL          0x00040001
 #define GLFW_CURSOR_HIDDEN          0x00040002
@@ -546,6 +552,19 @@ extern "C" {
 #define GLFW_CONNECTED              0x00061000
 #define GLFW_DISCONNECTED           0x00061001
 
+/*! @defgroup events Input event types
+ *  @ingroup input
+ *  @{ */
+#define GLFW_KEY_EVENT              0x00080001
+#define GLFW_CHAR_EVENT             0x00080002
+#define GLFW_MOUSE_BUTTON_EVENT     0x00080003
+#define GLFW_CURSOR_POS_EVENT       0x00080004
+#define GLFW_CURSOR_ENTER_EVENT     0x00080005
+#define GLFW_SCROLL_EVENT           0x00080006
+#define GLFW_JOYSTICK_AXIS_EVENT    0x00080007
+#define GLFW_JOYSTICK_BUTTON_EVENT  0x00080008
+/*! @} */
+
 
 /*************************************************************************
  * GLFW API types
@@ -615,6 +634,20 @@ typedef int (* GLFWwindowclosefun)(GLFWwindow*);
  */
 typedef void (* GLFWwindowrefreshfun)(GLFWwindow*);
 
+/*! @brief The function signature for window presentation callbacks.
+ *  @param[in] window The window whose buffer swap was presented.
+ *  @param[in] count The number of buffer swaps of the window completed so
+ *  far, including this one.
+ *  @param[in] msc The value of the vertical retrace counter of the monitor
+ *  when the swap was presented.
+ *  @param[in] time The time at which the swap was presented, in the time base
+ *  of @ref glfwGetTime.
+ *  @ingroup window
+ *
+ *  @sa glfwSetWindowPresentCallback
+ */
+typedef void (* GLFWwindowpresentfun)(GLFWwindow*,uint64_t,uint64_t,double);
+
 /*! @brief The function signature for window focus/defocus callbacks.
  *  @param[in] window The window that was focused or defocused.
  *  @param[in] focused @c GL_TRUE if the window was focused, or @c GL_FALSE if
@@ -705,6 +738,42 @@ typedef void (* GLFWcharfun)(GLFWwindow*,int);
  */
 typedef void (* GLFWmonitorfun)(GLFWmonitor*,int);
 
+/*! @brief The function signature for joystick configuration callbacks.
+ *  @param[in] joy The joystick that was connected or disconnected.
+ *  @param[in] event One of @c GLFW_CONNECTED or @c GLFW_DISCONNECTED.
+ *  @ingroup input
+ *
+ *  @sa glfwSetJoystickCallback
+ */
+typedef void (* GLFWjoystickfun)(int,int);
+
+/*! @brief The function signature for clipboard request callbacks.
+ *  @param[in] window The window that requested the clipboard contents.
+ *  @param[in] string The contents of the clipboard as a UTF-8 encoded string,
+ *  or @c NULL if that format was unavailable.
+ *  @ingroup clipboard
+ *
+ *  @note The string is valid only until the callback returns.
+ *
+ *  @sa glfwRequestClipboardString
+ */
+typedef void (* GLFWclipboardfun)(GLFWwindow*,const char*);
+
+/*! @brief The function signature for clipboard stream callbacks.
+ *  @param[in] window The window that requested the clipboard contents.
+ *  @param[in] data The next chunk of the clipboard contents, or @c NULL if
+ *  they could not be retrieved.
+ *  @param[in] length The length, in bytes, of the chunk, or zero when all
+ *  chunks have been delivered.
+ *  @ingroup clipboard
+ *
+ *  @note The chunk is valid only until the callback returns.  Chunks are not
+ *  terminated and may split multi-byte UTF-8 sequences.
+ *
+ *  @sa glfwRequestClipboardStream
+ */
+typedef void (* GLFWclipboardstreamfun)(GLFWwindow*,const char*,int);
+
 
 /* @brief Raw image data.
  * @note The data member must point to width * height * 4 bytes of 8bits RGBA data, bottom to top, left to right.
@@ -740,6 +809,60 @@ typedef struct
     unsigned short blue[GLFW_GAMMA_RAMP_SIZE];
 } GLFWgammaramp;
 
+/*! @brief Input event.
+ *
+ *  The members that are set depend on the @link events event type @endlink.
+ *  They carry the same values as the parameters of the corresponding callback.
+ *  All other members are zero.
+ *
+ *  @ingroup input
+ *
+ *  @sa glfwGetEvents
+ */
+typedef struct
+{
+    /*! The @link events type @endlink of the event. */
+    int type;
+    /*! The window that received the event. */
+    GLFWwindow* window;
+    /*! The key of a key event. */
+    int key;
+    /*! The mouse button of a mouse button event. */
+    int button;
+    /*! The action of a key or mouse button event. */
+    int action;
+    /*! The Unicode code point of a character event. */
+    int character;
+    /*! Whether the cursor entered or left the window in a cursor enter event. */
+    int entered;
+    /*! The cursor position of a cursor position event. */
+    int xpos, ypos;
+    /*! The scroll offsets of a scroll event. */
+    double xoffset, yoffset;
+    /*! The time of the event, in the time base of @ref glfwGetTime. */
+    double time;
+} GLFWevent;
+
+/*! @brief Joystick input event.
+ *
+ *  @ingroup input
+ *
+ *  @sa glfwGetJoystickEvents
+ */
+typedef struct
+{
+    /*! Either @c GLFW_JOYSTICK_AXIS_EVENT or @c GLFW_JOYSTICK_BUTTON_EVENT. */
+    int type;
+    /*! The index of the axis or button that changed. */
+    int index;
+    /*! The new value of the axis, for axis events. */
+    float value;
+    /*! The new state of the button, for button events. */
+    int action;
+    /*! The time of the event, in the time base of @ref glfwGetTime. */
+    double time;
+} GLFWjoystickevent;
+
 
 /*************************************************************************
  * GLFW API functions
@@ -1056,6 +1179,21 @@ GLFWAPI void glfwDefaultWindowHints(void);
  *  The @c GLFW_VISIBLE hint specifies whether the window will be initially
  *  visible.  This hint is ignored for fullscreen windows.
  *
+ *  The @c GLFW_HEADLESS hint specifies whether to create only an offscreen
+ *  context, without any window on screen.  The width and height passed to @ref
+ *  glfwCreateWindow then specify the size of its framebuffer.  Headless windows
+ *  cannot be fullscreen, and window operations such as showing, moving and
+ *  resizing them as well as clipboard access are silently ignored.  For these
+ *  windows, @ref glfwGetClipboardString returns @c NULL and clipboard requests
+ *  never call their callback.  Headless contexts can be made current and share
+ *  objects like any other context.
+ *
+ *  @note Headless contexts are currently only supported on X11, where GLX uses
+ *  a pbuffer and EGL uses a pbuffer or, if no config supports those and @c
+ *  EGL_KHR_surfaceless_context is available, no surface at all.  A surfaceless
+ *  context has no default framebuffer, so it must render to framebuffer
+ *  objects.
+ *
  *  @note This function may only be called from the main thread.
  *
  *  @sa glfwDefaultWindowHints
@@ -1304,6 +1442,9 @@ GLFWAPI GLFWmonitor* glfwGetWindowMonitor(GLFWwindow* window);
  *  The @c GLFW_RESIZABLE property indicates whether the window is resizable
  *  by the user.
  *
+ *  The @c GLFW_HEADLESS property indicates whether the window is headless,
+ *  i.e. has only an offscreen context.
+ *
  *  The @c GLFW_SHOULD_CLOSE property indicates whether the window has been
  *  requested by the user to close.
  *
@@ -1404,6 +1545,21 @@ GLFWAPI void glfwSetWindowCloseCallback(GLFWwindow* window, GLFWwindowclosefun c
  */
 GLFWAPI void glfwSetWindowRefreshCallback(GLFWwindow* window, GLFWwindowrefreshfun cbfun);
 
+/*! @brief Sets the presentation callback for the specified window.
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] cbfun The new callback, or @c NULL to remove the currently set
+ *  callback.
+ *  @ingroup window
+ *
+ *  This callback is called for each buffer swap of the window once it has
+ *  reached the screen.  Gaps in the vertical retrace counter between
+ *  consecutive swaps reveal dropped or repeated frames.
+ *
+ *  @note This callback is only called on X11, where either the
+ *  `GLX_INTEL_swap_event` extension or the Present extension is required.
+ */
+GLFWAPI void glfwSetWindowPresentCallback(GLFWwindow* window, GLFWwindowpresentfun cbfun);
+
 /*! @brief Sets the focus callback for the specified window.
  *  @param[in] window The window whose callback to set.
  *  @param[in] cbfun The new callback, or @c NULL to remove the currently set
@@ -1432,6 +1588,7 @@ GLFWAPI void glfwSetWindowIconifyCallback(GLFWwindow* window, GLFWwindowiconifyf
  *  @note This function may not be called from a callback.
  *
  *  @sa glfwWaitEvents
+ *  @sa glfwWaitEventsTimeout
  */
 GLFWAPI void glfwPollEvents(void);
 
@@ -1443,15 +1600,52 @@ GLFWAPI void glfwPollEvents(void);
  *  @note This function may not be called from a callback.
  *
  *  @sa glfwPollEvents
+ *  @sa glfwWaitEventsTimeout
  */
 GLFWAPI void glfwWaitEvents(void);
 
+/*! @brief Waits with timeout until events are pending and processes them.
+ *  @param[in] timeout The maximum amount of time, in seconds, to wait.
+ *  @ingroup window
+ *
+ *  This function puts the calling thread to sleep until at least one event has
+ *  been received or the specified timeout is reached, after which it processes
+ *  all pending events.  A timeout of zero is equivalent to @ref
+ *  glfwPollEvents.
+ *
+ *  @note This function may only be called from the main thread.
+ *
+ *  @note This function may not be called from a callback.
+ *
+ *  @sa glfwPollEvents
+ *  @sa glfwWaitEvents
+ */
+GLFWAPI void glfwWaitEventsTimeout(double timeout);
+
+/*! @brief Posts an empty event to the event queue.
+ *  @ingroup window
+ *
+ *  This function posts an empty event from the current thread to the main
+ *  thread event queue, causing @ref glfwWaitEvents or @ref
+ *  glfwWaitEventsTimeout to return.
+ *
+ *  @remarks This function may be called from secondary threads.
+ *
+ *  @sa glfwWaitEvents
+ *  @sa glfwWaitEventsTimeout
+ */
+GLFWAPI void glfwPostEmptyEvent(void);
+
 /*! @brief Returns the value of an input option for the specified window.
  *  @param[in] window The window to query.
  *  @param[in] mode One of the following:
  *  @arg @c GLFW_CURSOR_MODE Sets the cursor mode.
  *  @arg @c GLFW_STICKY_KEYS Sets whether sticky keys are enabled.
  *  @arg @c GLFW_STICKY_MOUSE_BUTTONS Sets whether sticky mouse buttons are enabled.
+ *  @arg @c GLFW_COALESCE_EVENTS Sets whether consecutive cursor motion and
+ *  window resize events are coalesced.
+ *  @arg @c GLFW_EVENT_QUEUE Sets whether input events are added to the event
+ *  queue of the window.
  *  @ingroup input
  *
  *  @sa glfwSetInputMode
@@ -1460,11 +1654,21 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
 
 /*! @brief Sets an input option for the specified window.
  *  @param[in] window The window whose input mode to set.
- *  @param[in] mode One of @c GLFW_CURSOR_MODE, @c GLFW_STICKY_KEYS or @c
- *  GLFW_STICKY_MOUSE_BUTTONS.
+ *  @param[in] mode One of @c GLFW_CURSOR_MODE, @c GLFW_STICKY_KEYS, @c
+ *  GLFW_STICKY_MOUSE_BUTTONS, @c GLFW_COALESCE_EVENTS or @c GLFW_EVENT_QUEUE.
  *  @param[in] value The new value of the specified input mode.
  *  @ingroup input
  *
+ *  @remarks When @c GLFW_COALESCE_EVENTS is enabled, runs of consecutive cursor
+ *  motion or window position and size events for the window that are pending
+ *  at the same time are reported only once, with their final values.  The
+ *  order of all other events is preserved.  This is disabled by default.
+ *
+ *  @remarks When @c GLFW_EVENT_QUEUE is enabled, every input event reported
+ *  for the window is also added to its event queue, where it can be retrieved
+ *  with @ref glfwGetEvents.  Callbacks are still called as usual.  Disabling
+ *  the event queue discards any events in it.  This is disabled by default.
+ *
  *  @sa glfwGetInputMode
  */
 GLFWAPI void glfwSetInputMode(GLFWwindow* window, int mode, int value);
@@ -1575,6 +1779,26 @@ GLFWAPI void glfwSetCursorEnterCallback(GLFWwindow* window, GLFWcursorenterfun c
  */
 GLFWAPI void glfwSetScrollCallback(GLFWwindow* window, GLFWscrollfun cbfun);
 
+/*! @brief Retrieves queued input events for the specified window.
+ *  @param[in] window The window whose event queue to read.
+ *  @param[out] events The array to hold the events.
+ *  @param[in] maxevents The size of the provided array.
+ *  @return The number of events written to @p events.
+ *  @ingroup input
+ *
+ *  This function removes up to @p maxevents events from the event queue of the
+ *  specified window, oldest first, and copies them into the provided array.
+ *  The queue is only filled if the @c GLFW_EVENT_QUEUE input mode is enabled.
+ *
+ *  @note This function may only be called from the main thread.
+ *
+ *  @note If the queue fills up between calls, the oldest events are discarded
+ *  to make room for new ones.
+ *
+ *  @sa glfwSetInputMode
+ */
+GLFWAPI int glfwGetEvents(GLFWwindow* window, GLFWevent* events, int maxevents);
+
 /*! @brief Returns a property of the specified joystick.
  *  @param[in] joy The joystick to query.
  *  @param[in] param The property whose value to return.
@@ -1613,6 +1837,55 @@ GLFWAPI int glfwGetJoystickButtons(int joy, unsigned char* buttons, int numbutto
  */
 GLFWAPI const char* glfwGetJoystickName(int joy);
 
+/*! @brief Retrieves queued input events for the specified joystick.
+ *  @param[in] joy The joystick whose event queue to read.
+ *  @param[out] events The array to hold the events.
+ *  @param[in] maxevents The size of the provided array.
+ *  @return The number of events written to @p events.
+ *  @ingroup input
+ *
+ *  This function removes up to @p maxevents events from the event queue of the
+ *  specified joystick, oldest first, and copies them into the provided array.
+ *  Every change of an axis or button is queued with the time it was reported
+ *  by the device, including those that happen between calls to @ref
+ *  glfwGetJoystickAxes and @ref glfwGetJoystickButtons.
+ *
+ *  @note If the queue fills up between calls, the oldest events are discarded
+ *  to make room for new ones.
+ *
+ *  @note This function returns zero on platforms where joystick input is only
+ *  available as its current state.
+ */
+GLFWAPI int glfwGetJoystickEvents(int joy, GLFWjoystickevent* events, int maxevents);
+
+/*! @brief Sets the joystick configuration callback.
+ *  @param[in] cbfun The new callback, or @c NULL to remove the currently set
+ *  callback.
+ *  @ingroup input
+ *
+ *  The callback is called from @ref glfwPollEvents and @ref glfwWaitEvents
+ *  when a joystick is connected or disconnected.  The slot of a disconnected
+ *  joystick may be reused for the next joystick that is connected.
+ *
+ *  @note On Windows, joystick configuration changes are not reported.  On Mac
+ *  OS X, only disconnections are reported.
+ */
+GLFWAPI void glfwSetJoystickCallback(GLFWjoystickfun cbfun);
+
+/*! @brief Enables or disables background reading of joystick input.
+ *  @param[in] enabled @c GL_TRUE to read joystick input on a separate thread,
+ *  or @c GL_FALSE to read it when joystick state is queried.
+ *  @ingroup input
+ *
+ *  When enabled, joystick input is read as it arrives by a thread owned by
+ *  GLFW and the joystick query functions only copy the most recent state.
+ *  This is disabled by default.
+ *
+ *  @note This function does nothing on platforms where querying joystick
+ *  state does not require reading pending input.
+ */
+GLFWAPI void glfwSetJoystickThread(int enabled);
+
 /*! @brief Sets the clipboard to the specified string.
  *  @param[in] window The window that will own the clipboard contents.
  *  @param[in] string A UTF-8 encoded string.
@@ -1639,6 +1912,67 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* window, const char* string);
  */
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* window);
 
+/*! @brief Requests the contents of the clipboard without waiting for them.
+ *  @param[in] window The window that will request the clipboard contents.
+ *  @param[in] cbfun The function to call with the clipboard contents.
+ *  @ingroup clipboard
+ *
+ *  This function starts retrieving the clipboard contents as a string and
+ *  returns immediately.  The callback is called once the contents are
+ *  available, during normal event processing.  On platforms where the
+ *  clipboard can be read without waiting on another process, the callback is
+ *  called before this function returns.
+ *
+ *  Each window can have only one pending request.  Requesting the clipboard
+ *  again before the callback has been called replaces the previous callback.
+ *
+ *  If the clipboard owner goes away or the timeout set with @ref
+ *  glfwSetClipboardTimeout passes before the contents have arrived, the
+ *  callback is called with @c NULL.
+ *
+ *  @note This function may only be called from the main thread.
+ *
+ *  @sa glfwGetClipboardString
+ */
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* window, GLFWclipboardfun cbfun);
+
+/*! @brief Requests the contents of the clipboard in chunks.
+ *  @param[in] window The window that will request the clipboard contents.
+ *  @param[in] cbfun The function to call with each chunk.
+ *  @ingroup clipboard
+ *
+ *  This function works like @ref glfwRequestClipboardString, except that the
+ *  contents are handed to the callback as they arrive instead of being
+ *  collected into a single string.  This avoids holding large clipboard
+ *  contents in memory twice.  After the last chunk, the callback is called
+ *  once more with a length of zero.
+ *
+ *  @note This function may only be called from the main thread.
+ *
+ *  @sa glfwRequestClipboardString
+ */
+GLFWAPI void glfwRequestClipboardStream(GLFWwindow* window, GLFWclipboardstreamfun cbfun);
+
+/*! @brief Sets the maximum time to wait for the clipboard contents.
+ *  @param[in] timeout The maximum time, in seconds, that @ref
+ *  glfwGetClipboardString may wait for the clipboard owner to reply, or zero
+ *  to wait indefinitely.
+ *  @ingroup clipboard
+ *
+ *  If the owner of the clipboard has not replied within the timeout, @ref
+ *  glfwGetClipboardString returns @c NULL.  Requests made with @ref
+ *  glfwRequestClipboardString or @ref glfwRequestClipboardStream that have not
+ *  completed within the timeout call their callback with @c NULL.  The default
+ *  is to wait indefinitely.
+ *
+ *  @note This only has an effect on platforms where retrieving the clipboard
+ *  contents requires waiting on another process.
+ *
+ *  @sa glfwGetClipboardString
+ *  @sa glfwRequestClipboardString
+ */
+GLFWAPI void glfwSetClipboardTimeout(double timeout);
+
 /*! @brief Retrieves the current value of the GLFW timer.
  *  @return The current value, in seconds.
  *  @ingroup time
@@ -1660,6 +1994,68 @@ GLFWAPI double glfwGetTime(void);
  */
 GLFWAPI void glfwSetTime(double time);
 
+/*! @brief Returns the current value of the raw timer.
+ *  @return The value of the timer, in units of 1 / @ref glfwGetTimerFrequency
+ *  seconds.
+ *  @ingroup time
+ *
+ *  This function returns the counter of the monotonic system timer that the
+ *  GLFW timer is based on, without any conversion to floating point.  The
+ *  value is not affected by @ref glfwSetTime and has an arbitrary epoch, so
+ *  only differences between values are meaningful.
+ *
+ *  @remarks This function may be called from secondary threads.
+ */
+GLFWAPI uint64_t glfwGetTimerValue(void);
+
+/*! @brief Returns the frequency of the raw timer.
+ *  @return The frequency of the timer, in Hz.
+ *  @ingroup time
+ *
+ *  @remarks This function may be called from secondary threads.
+ *
+ *  @sa glfwGetTimerValue
+ */
+GLFWAPI uint64_t glfwGetTimerFrequency(void);
+
+/*! @brief Waits until the GLFW timer reaches the specified time.
+ *  @param[in] time The time to wait for, in the time base of @ref
+ *  glfwGetTime.
+ *  @ingroup time
+ *
+ *  This function puts the calling thread to sleep until shortly before the
+ *  specified time and then waits actively for the remainder, so that it
+ *  returns as close to the specified time as possible without spending more
+ *  processor time than needed.  The length of the active wait is adjusted to
+ *  the wake-up latency observed on previous calls.  It returns immediately if
+ *  the time has already passed.
+ *
+ *  @remarks This function may be called from secondary threads.
+ *
+ *  @note This function does not process events.  To wait for events with a
+ *  time limit, use @ref glfwWaitEventsTimeout.
+ */
+GLFWAPI void glfwWaitUntil(double time);
+
+/*! @brief Returns the time of the event currently being processed.
+ *  @return The time, in the time base of @ref glfwGetTime, at which the event
+ *  most recently processed by @ref glfwPollEvents or @ref glfwWaitEvents
+ *  occurred.
+ *  @ingroup time
+ *
+ *  @remarks When called from a callback, this is the time of the event that
+ *  caused the callback to be called.
+ *
+ *  @note <b>X11:</b> Event times are derived from server timestamps, where
+ *  available, and are estimated to be no later than the time the event was
+ *  received.
+ *
+ *  @note <b>Windows:</b> Event times are the time GLFW received the event.
+ *
+ *  @note This function may only be called from the main thread.
+ */
+GLFWAPI double glfwGetEventTime(void);
+
 /*! @brief Makes the context of the specified window current for this thread.
  *  @param[in] window The window whose context to make current, or @c NULL to
  *  detach the current context.
@@ -1699,8 +2095,17 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* window);
  *  until the buffers are swapped by @ref glfwSwapBuffers.
  *  @ingroup context
  *
+ *  A negative interval enables adaptive vertical synchronization, where a swap
+ *  that misses the vertical retrace it was meant for happens immediately
+ *  instead of waiting for the next one.  The magnitude of the interval is used
+ *  as the number of video frame periods to wait.
+ *
  *  @remarks This function may be called from secondary threads.
  *
+ *  @note Adaptive vertical synchronization requires the
+ *  `GLX_EXT_swap_control_tear` or `WGL_EXT_swap_control_tear` extension.
+ *  Where it is not available, a negative interval is treated as its magnitude.
+ *
  *  @sa glfwSwapBuffers
  */
 GLFWAPI void glfwSwapInterval(int interval);
@@ -1728,6 +2133,30 @@ GLFWAPI int glfwExtensionSupported(const char* extension);
  */
 GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname);
 
+/*! @brief Returns the addresses of the specified client API functions for the
+ *  current context.
+ *  @param[in] procnames An array of ASCII encoded function names.
+ *  @param[out] procs Where to store the function addresses.  Each element is
+ *  set to the address of the function at the same index in @c procnames, or to
+ *  @c NULL if that function is unavailable.
+ *  @param[in] count The number of elements in both arrays.
+ *  @return The number of functions that were found.
+ *  @ingroup context
+ *
+ *  This function is equivalent to calling @ref glfwGetProcAddress for each
+ *  name, but lets a loader fill an entire table of entry points in one call.
+ *
+ *  @remarks This function may be called from secondary threads.
+ *
+ *  @note Function addresses are cached per context, so resolving the same
+ *  function again for the same context does not query the system.
+ *
+ *  @sa glfwGetProcAddress
+ */
+GLFWAPI int glfwGetProcAddresses(const char** procnames,
+                                 GLFWglproc* procs,
+                                 int count);
+
 
 /*************************************************************************
  * Global definition cleanup
@@ -40,14 +40,67 @@
 GLFWAPI void glfwSetClipboardString(GLFWwindow* handle, const char* string)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
+
     _GLFW_REQUIRE_INIT();
+
+    // Clipboard access is ignored for headless windows
+    if (window->headless)
+        return;
+
     _glfwPlatformSetClipboardString(window, string);
 }
 
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* handle)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
+
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    // Clipboard access is ignored for headless windows
+    if (window->headless)
+        return NULL;
+
     return _glfwPlatformGetClipboardString(window);
 }
 
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* handle,
+                                        GLFWclipboardfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+
+    _GLFW_REQUIRE_INIT();
+
+    // Clipboard access is ignored for headless windows
+    if (window->headless)
+        return;
+
+    _glfwPlatformRequestClipboardString(window, cbfun);
+}
+
+GLFWAPI void glfwRequestClipboardStream(GLFWwindow* handle,
+                                        GLFWclipboardstreamfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+
+    _GLFW_REQUIRE_INIT();
+
+    // Clipboard access is ignored for headless windows
+    if (window->headless)
+        return;
+
+    _glfwPlatformRequestClipboardStream(window, cbfun);
+}
+
+GLFWAPI void glfwSetClipboardTimeout(double timeout)
+{
+    _GLFW_REQUIRE_INIT();
+
+    if (timeout < 0.0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid timeout");
+        return;
+    }
+
+    _glfw.clipboardTimeout = timeout;
+}
+
@@ -71,3 +71,25 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
     return _glfw.ns.clipboardString;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun)
+{
+    // The pasteboard is read without waiting on the owner
+    cbfun((GLFWwindow*) window, _glfwPlatformGetClipboardString(window));
+}
+
+void _glfwPlatformRequestClipboardStream(_GLFWwindow* window,
+                                         GLFWclipboardstreamfun cbfun)
+{
+    // The pasteboard is read without waiting on the owner
+    const char* string = _glfwPlatformGetClipboardString(window);
+    if (!string)
+    {
+        cbfun((GLFWwindow*) window, NULL, 0);
+        return;
+    }
+
+    cbfun((GLFWwindow*) window, string, (int) strlen(string));
+    cbfun((GLFWwindow*) window, "", 0);
+}
+
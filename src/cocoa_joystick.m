@@ -237,7 +237,11 @@ static void removeJoystick(_GLFWjoy* joystick)
 //
 static void removalCallback(void* target, IOReturn result, void* refcon, void* sender)
 {
-    removeJoystick((_GLFWjoy*) refcon);
+    _GLFWjoy* joystick = (_GLFWjoy*) refcon;
+
+    removeJoystick(joystick);
+    _glfwInputJoystickChange((int) (joystick - _glfw.ns.joysticks),
+                             GLFW_DISCONNECTED);
 }
 
 // Polls for joystick events and updates GLFW state
@@ -565,3 +569,14 @@ const char* _glfwPlatformGetJoystickName(int joy)
     return _glfw.ns.joysticks[joy].name;
 }
 
+int _glfwPlatformGetJoystickEvents(int joy, GLFWjoystickevent* events, int maxevents)
+{
+    // The HID device interfaces only provide the current element values
+    return 0;
+}
+
+void _glfwPlatformSetJoystickThread(int enabled)
+{
+    // The joystick API reads the current element values directly
+}
+
@@ -106,6 +106,7 @@ typedef struct _GLFWlibraryNS
 {
     struct {
         double      base;
+        uint64_t    frequency;
         double      resolution;
     } timer;
 
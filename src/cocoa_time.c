@@ -51,6 +51,7 @@ void _glfwInitTimer(void)
     mach_timebase_info_data_t info;
     mach_timebase_info(&info);
 
+    _glfw.ns.timer.frequency = (info.denom * (uint64_t) 1000000000) / info.numer;
     _glfw.ns.timer.resolution = (double) info.numer / (info.denom * 1.0e9);
     _glfw.ns.timer.base = getRawTime();
 }
@@ -72,3 +73,22 @@ void _glfwPlatformSetTime(double time)
         (uint64_t) (time / _glfw.ns.timer.resolution);
 }
 
+uint64_t _glfwPlatformGetTimerValue(void)
+{
+    return getRawTime();
+}
+
+uint64_t _glfwPlatformGetTimerFrequency(void)
+{
+    return _glfw.ns.timer.frequency;
+}
+
+void _glfwPlatformWaitUntil(double time)
+{
+    const double deadline = _glfw.ns.timer.base + time / _glfw.ns.timer.resolution;
+
+    // mach_wait_until is precise enough on its own to not need an active wait
+    if (deadline > (double) getRawTime())
+        mach_wait_until((uint64_t) deadline);
+}
+
@@ -507,6 +507,11 @@ static int convertMacKeyCode(unsigned int macKeyCode)
 // down the command key don't get sent to the key window.
 - (void)sendEvent:(NSEvent *)event
 {
+    // Event timestamps are in seconds of system uptime, which is the same
+    // clock as mach_absolute_time
+    _glfw.eventTime = [event timestamp] -
+                      _glfw.ns.timer.base * _glfw.ns.timer.resolution;
+
     if ([event type] == NSKeyUp && ([event modifierFlags] & NSCommandKeyMask))
         [[self keyWindow] sendEvent:event];
     else
@@ -701,6 +706,13 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
                               const _GLFWwndconfig* wndconfig,
                               const _GLFWfbconfig* fbconfig)
 {
+    if (wndconfig->headless)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "Cocoa: Headless windows are not supported");
+        return GL_FALSE;
+    }
+
     if (!initializeAppKit())
         return GL_FALSE;
 
@@ -888,6 +900,35 @@ void _glfwPlatformWaitEvents(void)
     _glfwPlatformPollEvents();
 }
 
+void _glfwPlatformWaitEventsTimeout(double timeout)
+{
+    NSDate* date = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    NSEvent* event = [NSApp nextEventMatchingMask:NSAnyEventMask
+                                        untilDate:date
+                                           inMode:NSDefaultRunLoopMode
+                                          dequeue:YES];
+    if (event)
+        [NSApp sendEvent:event];
+
+    _glfwPlatformPollEvents();
+}
+
+void _glfwPlatformPostEmptyEvent(void)
+{
+    NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
+    NSEvent* event = [NSEvent otherEventWithType:NSApplicationDefined
+                                        location:NSMakePoint(0, 0)
+                                   modifierFlags:0
+                                       timestamp:0
+                                    windowNumber:0
+                                         context:nil
+                                         subtype:0
+                                           data1:0
+                                           data2:0];
+    [NSApp postEvent:event atStart:YES];
+    [pool drain];
+}
+
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, int x, int y)
 {
     if (window->monitor)
@@ -32,6 +32,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include <limits.h>
 #include <stdio.h>
 
@@ -85,6 +86,179 @@ static GLboolean parseGLVersion(int* api, int* major, int* minor, int* rev)
     return GL_TRUE;
 }
 
+// Returns the FNV-1a hash of the specified extension or function name
+//
+static unsigned int hashName(const char* name, size_t length)
+{
+    size_t i;
+    unsigned int hash = 2166136261u;
+
+    for (i = 0;  i < length;  i++)
+    {
+        hash ^= (unsigned char) name[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Returns the slot of the specified name in the set's table, or -1 if the set
+// does not contain it
+//
+static int findName(const _GLFWextset* set, const char* name, size_t length)
+{
+    unsigned int i;
+
+    if (!set->size)
+        return -1;
+
+    i = hashName(name, length) & (set->size - 1);
+
+    while (set->names[i])
+    {
+        if (strncmp(set->names[i], name, length) == 0 &&
+            set->names[i][length] == '\0')
+        {
+            return (int) i;
+        }
+
+        i = (i + 1) & (set->size - 1);
+    }
+
+    return -1;
+}
+
+// Places an already allocated name and its entry point in the first free slot
+// of its probe sequence
+//
+static void placeName(_GLFWextset* set, char* name, GLFWglproc proc)
+{
+    unsigned int i = hashName(name, strlen(name)) & (set->size - 1);
+
+    while (set->names[i])
+        i = (i + 1) & (set->size - 1);
+
+    set->names[i] = name;
+    if (set->procs)
+        set->procs[i] = proc;
+}
+
+// Adds a name of the specified length that is not yet in the set, along with
+// its entry point if the set stores them
+//
+static void insertName(_GLFWextset* set, const char* name, size_t length,
+                       GLboolean withProcs, GLFWglproc proc)
+{
+    char* copy;
+
+    // Keep the table at most half full to keep probe sequences short
+    if ((set->count + 1) * 2 > set->size)
+    {
+        unsigned int i;
+        _GLFWextset grown;
+
+        grown.size = set->size ? set->size * 2 : 256;
+        grown.count = set->count;
+        grown.names = (char**) calloc(grown.size, sizeof(char*));
+        grown.procs = NULL;
+
+        if (withProcs)
+            grown.procs = (GLFWglproc*) calloc(grown.size, sizeof(GLFWglproc));
+
+        if (!grown.names || (withProcs && !grown.procs))
+        {
+            free(grown.names);
+            free(grown.procs);
+            return;
+        }
+
+        for (i = 0;  i < set->size;  i++)
+        {
+            if (set->names[i])
+            {
+                placeName(&grown, set->names[i],
+                          set->procs ? set->procs[i] : NULL);
+            }
+        }
+
+        free(set->names);
+        free(set->procs);
+        *set = grown;
+    }
+
+    copy = (char*) malloc(length + 1);
+    if (!copy)
+        return;
+
+    memcpy(copy, name, length);
+    copy[length] = '\0';
+
+    placeName(set, copy, proc);
+    set->count++;
+}
+
+// Adds a single extension name of the specified length to the set
+//
+static void addExtension(_GLFWextset* set, const char* name, size_t length)
+{
+    if (findName(set, name, length) == -1)
+        insertName(set, name, length, GL_FALSE, NULL);
+}
+
+// Returns the address of the specified function for the specified context,
+// resolving it through the platform only the first time it is requested
+//
+static GLFWglproc getProcAddress(_GLFWwindow* window, const char* procname)
+{
+    GLFWglproc proc;
+    const size_t length = strlen(procname);
+    const int slot = findName(&window->procs, procname, length);
+
+    if (slot != -1)
+        return window->procs.procs[slot];
+
+    // Unavailable functions are cached as well, so that probing for optional
+    // entry points does not repeat the symbol lookup either
+    proc = _glfwPlatformGetProcAddress(procname);
+
+    insertName(&window->procs, procname, length, GL_TRUE, proc);
+
+    return proc;
+}
+
+// Builds the extension set of the current context
+//
+static void initContextExtensions(_GLFWwindow* window)
+{
+    _glfwFreeExtensionSet(&window->extensions);
+
+    if (window->glMajor < 3)
+    {
+        const GLubyte* extensions = glGetString(GL_EXTENSIONS);
+        if (extensions != NULL)
+        {
+            _glfwAddExtensionString(&window->extensions,
+                                    (const char*) extensions);
+        }
+    }
+#if defined(_GLFW_USE_OPENGL)
+    else
+    {
+        int i;
+        GLint count;
+
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+        for (i = 0;  i < count;  i++)
+        {
+            const char* name = (const char*) window->GetStringi(GL_EXTENSIONS, i);
+            if (name != NULL)
+                addExtension(&window->extensions, name, strlen(name));
+        }
+    }
+#endif // _GLFW_USE_OPENGL
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -231,7 +405,11 @@ GLboolean _glfwRefreshContextParams(void)
             return GL_FALSE;
         }
     }
+#endif // _GLFW_USE_OPENGL
+
+    initContextExtensions(window);
 
+#if defined(_GLFW_USE_OPENGL)
     if (window->clientAPI == GLFW_OPENGL_API)
     {
         // Read back context flags (OpenGL 3.0 and above)
@@ -326,6 +504,223 @@ GLboolean _glfwIsValidContext(_GLFWwndconfig* wndconfig)
     return GL_TRUE;
 }
 
+const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
+                                         const _GLFWfbconfig* alternatives,
+                                         unsigned int count)
+{
+    unsigned int i;
+    unsigned int missing, leastMissing = UINT_MAX;
+    unsigned int colorDiff, leastColorDiff = UINT_MAX;
+    unsigned int extraDiff, leastExtraDiff = UINT_MAX;
+    GLboolean slow, leastSlow = GL_TRUE;
+    const _GLFWfbconfig* current;
+    const _GLFWfbconfig* closest = NULL;
+
+    for (i = 0;  i < count;  i++)
+    {
+        current = alternatives + i;
+
+        if (desired->stereo && !current->stereo)
+        {
+            // Stereo is a hard constraint
+            continue;
+        }
+
+        // Count number of missing buffers
+        {
+            missing = 0;
+
+            if (desired->alphaBits > 0 && current->alphaBits == 0)
+                missing++;
+
+            if (desired->depthBits > 0 && current->depthBits == 0)
+                missing++;
+
+            if (desired->stencilBits > 0 && current->stencilBits == 0)
+                missing++;
+
+            if (desired->auxBuffers > 0 &&
+                current->auxBuffers < desired->auxBuffers)
+            {
+                missing += desired->auxBuffers - current->auxBuffers;
+            }
+
+            if (desired->samples > 0 && current->samples == 0)
+            {
+                // Technically, several multisampling buffers could be
+                // involved, but that's a lower level implementation detail and
+                // not important to us here, so we count them as one
+                missing++;
+            }
+        }
+
+        // These polynomials make many small channel size differences matter
+        // less than one large channel size difference
+
+        // Calculate color channel size difference value
+        {
+            colorDiff = 0;
+
+            if (desired->redBits > 0)
+            {
+                colorDiff += (desired->redBits - current->redBits) *
+                             (desired->redBits - current->redBits);
+            }
+
+            if (desired->greenBits > 0)
+            {
+                colorDiff += (desired->greenBits - current->greenBits) *
+                             (desired->greenBits - current->greenBits);
+            }
+
+            if (desired->blueBits > 0)
+            {
+                colorDiff += (desired->blueBits - current->blueBits) *
+                             (desired->blueBits - current->blueBits);
+            }
+        }
+
+        // Calculate non-color channel size difference value
+        {
+            extraDiff = 0;
+
+            if (desired->alphaBits > 0)
+            {
+                extraDiff += (desired->alphaBits - current->alphaBits) *
+                             (desired->alphaBits - current->alphaBits);
+            }
+
+            if (desired->depthBits > 0)
+            {
+                extraDiff += (desired->depthBits - current->depthBits) *
+                             (desired->depthBits - current->depthBits);
+            }
+
+            if (desired->stencilBits > 0)
+            {
+                extraDiff += (desired->stencilBits - current->stencilBits) *
+                             (desired->stencilBits - current->stencilBits);
+            }
+
+            if (desired->accumRedBits > 0)
+            {
+                extraDiff += (desired->accumRedBits - current->accumRedBits) *
+                             (desired->accumRedBits - current->accumRedBits);
+            }
+
+            if (desired->accumGreenBits > 0)
+            {
+                extraDiff += (desired->accumGreenBits - current->accumGreenBits) *
+                             (desired->accumGreenBits - current->accumGreenBits);
+            }
+
+            if (desired->accumBlueBits > 0)
+            {
+                extraDiff += (desired->accumBlueBits - current->accumBlueBits) *
+                             (desired->accumBlueBits - current->accumBlueBits);
+            }
+
+            if (desired->accumAlphaBits > 0)
+            {
+                extraDiff += (desired->accumAlphaBits - current->accumAlphaBits) *
+                             (desired->accumAlphaBits - current->accumAlphaBits);
+            }
+
+            if (desired->samples > 0)
+            {
+                extraDiff += (desired->samples - current->samples) *
+                             (desired->samples - current->samples);
+            }
+
+            if (desired->sRGB && !current->sRGB)
+                extraDiff++;
+        }
+
+        // Penalize buffers that were not asked for, as they cost memory and
+        // bandwidth for nothing
+        {
+            if (desired->accumRedBits == 0)
+                extraDiff += current->accumRedBits * current->accumRedBits;
+
+            if (desired->accumGreenBits == 0)
+                extraDiff += current->accumGreenBits * current->accumGreenBits;
+
+            if (desired->accumBlueBits == 0)
+                extraDiff += current->accumBlueBits * current->accumBlueBits;
+
+            if (desired->accumAlphaBits == 0)
+                extraDiff += current->accumAlphaBits * current->accumAlphaBits;
+
+            if (desired->auxBuffers == 0)
+                extraDiff += current->auxBuffers * current->auxBuffers;
+
+            if (desired->samples == 0)
+                extraDiff += current->samples * current->samples;
+        }
+
+        slow = current->slow;
+
+        // Figure out if the current one is better than the best one found so far
+        // Least number of missing buffers is the most important heuristic,
+        // then color buffer size match, then size match for other buffers and
+        // lastly whether the config is slow or non-conformant
+
+        if (missing < leastMissing)
+            closest = current;
+        else if (missing == leastMissing)
+        {
+            if ((colorDiff < leastColorDiff) ||
+                (colorDiff == leastColorDiff && extraDiff < leastExtraDiff) ||
+                (colorDiff == leastColorDiff && extraDiff == leastExtraDiff &&
+                 !slow && leastSlow))
+            {
+                closest = current;
+            }
+        }
+
+        if (current == closest)
+        {
+            leastMissing = missing;
+            leastColorDiff = colorDiff;
+            leastExtraDiff = extraDiff;
+            leastSlow = slow;
+        }
+    }
+
+    return closest;
+}
+
+void _glfwAddExtensionString(_GLFWextset* set, const char* string)
+{
+    while (*string)
+    {
+        size_t length = strcspn(string, " ");
+        if (length)
+            addExtension(set, string, length);
+
+        string += length;
+        while (*string == ' ')
+            string++;
+    }
+}
+
+GLboolean _glfwExtensionInSet(const _GLFWextset* set, const char* name)
+{
+    return findName(set, name, strlen(name)) != -1;
+}
+
+void _glfwFreeExtensionSet(_GLFWextset* set)
+{
+    unsigned int i;
+
+    for (i = 0;  i < set->size;  i++)
+        free(set->names[i]);
+
+    free(set->names);
+    free(set->procs);
+    memset(set, 0, sizeof(_GLFWextset));
+}
+
 int _glfwStringInExtensionString(const char* string, const GLubyte* extensions)
 {
     const GLubyte* start;
@@ -400,7 +795,6 @@ GLFWAPI void glfwSwapInterval(int interval)
 
 GLFWAPI int glfwExtensionSupported(const char* extension)
 {
-    const GLubyte* extensions;
     _GLFWwindow* window;
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GL_FALSE);
@@ -418,52 +812,59 @@ GLFWAPI int glfwExtensionSupported(const char* extension)
         return GL_FALSE;
     }
 
-    if (window->glMajor < 3)
-    {
-        // Check if extension is in the old style OpenGL extensions string
+    // Check if extension is in the extension set of the current context
+    if (_glfwExtensionInSet(&window->extensions, extension))
+        return GL_TRUE;
 
-        extensions = glGetString(GL_EXTENSIONS);
-        if (extensions != NULL)
-        {
-            if (_glfwStringInExtensionString(extension, extensions))
-                return GL_TRUE;
-        }
-    }
-#if defined(_GLFW_USE_OPENGL)
-    else
-    {
-        int i;
-        GLint count;
+    // Check if extension is in the platform-specific extension set
+    return _glfwPlatformExtensionSupported(extension);
+}
 
-        // Check if extension is in the modern OpenGL extensions string list
+GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname)
+{
+    _GLFWwindow* window;
 
-        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-        for (i = 0;  i < count;  i++)
-        {
-             if (strcmp((const char*) window->GetStringi(GL_EXTENSIONS, i),
-                         extension) == 0)
-             {
-                 return GL_TRUE;
-             }
-        }
+    window = _glfwPlatformGetCurrentContext();
+    if (!window)
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT, NULL);
+        return NULL;
     }
-#endif // _GLFW_USE_OPENGL
 
-    // Check if extension is in the platform-specific string
-    return _glfwPlatformExtensionSupported(extension);
+    return getProcAddress(window, procname);
 }
 
-GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname)
+GLFWAPI int glfwGetProcAddresses(const char** procnames,
+                                 GLFWglproc* procs,
+                                 int count)
 {
-    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    int i, found = 0;
+    _GLFWwindow* window;
 
-    if (!_glfwPlatformGetCurrentContext())
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    window = _glfwPlatformGetCurrentContext();
+    if (!window)
     {
         _glfwInputError(GLFW_NO_CURRENT_CONTEXT, NULL);
-        return NULL;
+        return 0;
+    }
+
+    if (count < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, NULL);
+        return 0;
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        procs[i] = getProcAddress(window, procnames[i]);
+        if (procs[i])
+            found++;
     }
 
-    return _glfwPlatformGetProcAddress(procname);
+    return found;
 }
 
@@ -128,9 +128,20 @@ int _glfwInitContextAPI(void)
         return GL_FALSE;
     }
 
+    // Cache the EGL extensions once, as they do not change for a display
+    {
+        const char* extensions = eglQueryString(_glfw.egl.display,
+                                                EGL_EXTENSIONS);
+        if (extensions != NULL)
+            _glfwAddExtensionString(&_glfw.egl.extensions, extensions);
+    }
+
     if (_glfwPlatformExtensionSupported("EGL_KHR_create_context"))
         _glfw.egl.KHR_create_context = GL_TRUE;
 
+    if (_glfwPlatformExtensionSupported("EGL_KHR_surfaceless_context"))
+        _glfw.egl.KHR_surfaceless_context = GL_TRUE;
+
     return GL_TRUE;
 }
 
@@ -138,6 +149,7 @@ int _glfwInitContextAPI(void)
 //
 void _glfwTerminateContextAPI(void)
 {
+    _glfwFreeExtensionSet(&_glfw.egl.extensions);
     eglTerminate(_glfw.egl.display);
 }
 
@@ -164,7 +176,7 @@ int _glfwCreateContext(_GLFWwindow* window,
 
     // Retrieve the previously selected EGLConfig
     {
-        int index = 0;
+        int index = 0, surfaceTypeIndex = -1;
 
         setEGLattrib(EGL_COLOR_BUFFER_TYPE, EGL_RGB_BUFFER);
 
@@ -188,9 +200,25 @@ int _glfwCreateContext(_GLFWwindow* window,
             setEGLattrib(EGL_SAMPLES, fbconfig->samples);
         }
 
+        // Headless contexts need a config supporting pbuffers, unless they can
+        // be made current without any surface
+        if (wndconfig->headless)
+        {
+            setEGLattrib(EGL_SURFACE_TYPE, EGL_PBUFFER_BIT);
+            surfaceTypeIndex = index - 1;
+        }
+
         setEGLattrib(EGL_NONE, EGL_NONE);
 
         eglChooseConfig(_glfw.egl.display, attribs, &config, 1, &count);
+        if (!count && surfaceTypeIndex != -1 &&
+            _glfw.egl.KHR_surfaceless_context)
+        {
+            // Retry without requiring any surface type
+            attribs[surfaceTypeIndex] = 0;
+            eglChooseConfig(_glfw.egl.display, attribs, &config, 1, &count);
+        }
+
         if (!count)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -202,6 +230,7 @@ int _glfwCreateContext(_GLFWwindow* window,
 
 #if defined(_GLFW_X11)
     // Retrieve the visual corresponding to the chosen EGL config
+    if (!wndconfig->headless)
     {
         int mask;
         EGLint redBits, greenBits, blueBits, alphaBits, visualID = 0;
@@ -340,6 +369,35 @@ int _glfwCreateContext(_GLFWwindow* window,
 
     window->egl.config = config;
 
+    if (wndconfig->headless)
+    {
+        EGLint surfaceTypes = 0;
+
+        eglGetConfigAttrib(_glfw.egl.display, config,
+                           EGL_SURFACE_TYPE, &surfaceTypes);
+
+        // Without pbuffer support the config was chosen for a surfaceless
+        // context, which is made current without any surface
+        if (surfaceTypes & EGL_PBUFFER_BIT)
+        {
+            int index = 0;
+
+            setEGLattrib(EGL_WIDTH, wndconfig->width);
+            setEGLattrib(EGL_HEIGHT, wndconfig->height);
+            setEGLattrib(EGL_NONE, EGL_NONE);
+
+            window->egl.surface = eglCreatePbufferSurface(_glfw.egl.display,
+                                                          config, attribs);
+            if (window->egl.surface == EGL_NO_SURFACE)
+            {
+                _glfwInputError(GLFW_PLATFORM_ERROR,
+                                "EGL: Failed to create pbuffer surface: %s",
+                                getErrorString(eglGetError()));
+                return GL_FALSE;
+            }
+        }
+    }
+
     return GL_TRUE;
 }
 
@@ -370,6 +428,27 @@ void _glfwDestroyContext(_GLFWwindow* window)
     }
 }
 
+#if defined(_GLFW_X11)
+
+// Requests swap completion events for the specified window
+// Returns GL_FALSE if they are not supported
+//
+GLboolean _glfwSelectSwapEvents(_GLFWwindow* window)
+{
+    // EGL has no swap completion events
+    return GL_FALSE;
+}
+
+// Reports the presentation of a buffer swap if the specified event is a swap
+// completion event
+//
+GLboolean _glfwHandleSwapEvent(XEvent* event)
+{
+    return GL_FALSE;
+}
+
+#endif // _GLFW_X11
+
 // Analyzes the specified context for possible recreation
 //
 int _glfwAnalyzeContext(const _GLFWwindow* window,
@@ -392,7 +471,7 @@ void _glfwPlatformMakeContextCurrent(_GLFWwindow* window)
 {
     if (window)
     {
-        if (window->egl.surface == EGL_NO_SURFACE)
+        if (window->egl.surface == EGL_NO_SURFACE && !window->headless)
         {
             window->egl.surface = eglCreateWindowSurface(_glfw.egl.display,
                                                          window->egl.config,
@@ -427,26 +506,26 @@ _GLFWwindow* _glfwPlatformGetCurrentContext(void)
 
 void _glfwPlatformSwapBuffers(_GLFWwindow* window)
 {
+    // Surfaceless contexts have no buffers to swap
+    if (window->egl.surface == EGL_NO_SURFACE)
+        return;
+
     eglSwapBuffers(_glfw.egl.display, window->egl.surface);
 }
 
 void _glfwPlatformSwapInterval(int interval)
 {
+    // EGL has no adaptive swap interval and clamps negative values to its
+    // minimum, so the magnitude is used instead
+    if (interval < 0)
+        interval = -interval;
+
     eglSwapInterval(_glfw.egl.display, interval);
 }
 
 int _glfwPlatformExtensionSupported(const char* extension)
 {
-    const char* extensions;
-
-    extensions = eglQueryString(_glfw.egl.display, EGL_EXTENSIONS);
-    if (extensions != NULL)
-    {
-        if (_glfwStringInExtensionString(extension, (unsigned char*) extensions))
-            return GL_TRUE;
-    }
-
-    return GL_FALSE;
+    return _glfwExtensionInSet(&_glfw.egl.extensions, extension);
 }
 
 GLFWglproc _glfwPlatformGetProcAddress(const char* procname)
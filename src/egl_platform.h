@@ -74,7 +74,9 @@ typedef struct _GLFWlibraryEGL
     EGLDisplay      display;
     EGLint          versionMajor, versionMinor;
 
+    _GLFWextset     extensions;
     GLboolean       KHR_create_context;
+    GLboolean       KHR_surfaceless_context;
 
 } _GLFWlibraryEGL;
 
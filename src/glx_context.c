@@ -94,6 +94,186 @@ static GLXContext createLegacyContext(_GLFWwindow* window,
     }
 }
 
+// Returns the GLX drawable of the specified window
+//
+static GLXDrawable getDrawable(_GLFWwindow* window)
+{
+    if (window->glx.pbuffer)
+        return window->glx.pbuffer;
+
+    return window->x11.handle;
+}
+
+// Returns the specified attribute of the specified GLXFBConfig
+//
+static int getFBConfigAttrib(GLXFBConfig fbconfig, int attrib)
+{
+    int value = 0;
+
+    if (_glfw.glx.SGIX_fbconfig)
+    {
+        _glfw.glx.GetFBConfigAttribSGIX(_glfw.x11.display,
+                                        fbconfig, attrib, &value);
+    }
+    else
+        glXGetFBConfigAttrib(_glfw.x11.display, fbconfig, attrib, &value);
+
+    return value;
+}
+
+// Enumerates the GLXFBConfigs usable for windows and caches their properties
+// Returns GL_FALSE if the cache could not be allocated
+//
+static GLboolean initFBConfigs(void)
+{
+    int i, count;
+    GLXFBConfig* native;
+
+    if (_glfw.glx.SGIX_fbconfig)
+    {
+        // There is no SGIX equivalent of glXGetFBConfigs, so every attribute
+        // GLFW filters on itself is passed as GLX_DONT_CARE, overriding the
+        // window-only RGBA defaults of the chooser
+        int attribs[] =
+        {
+            GLX_DRAWABLE_TYPE_SGIX, GLX_DONT_CARE,
+            GLX_RENDER_TYPE_SGIX, GLX_DONT_CARE,
+            GLX_X_RENDERABLE_SGIX, GLX_DONT_CARE,
+            GLX_DOUBLEBUFFER, GLX_DONT_CARE,
+            None
+        };
+
+        native = _glfw.glx.ChooseFBConfigSGIX(_glfw.x11.display,
+                                              _glfw.x11.screen,
+                                              attribs,
+                                              &count);
+    }
+    else
+        native = glXGetFBConfigs(_glfw.x11.display, _glfw.x11.screen, &count);
+
+    if (native == NULL)
+        return GL_TRUE;
+
+    _glfw.glx.native = native;
+    _glfw.glx.configs = (_GLFWfbconfig*) calloc(count, sizeof(_GLFWfbconfig));
+    _glfw.glx.drawableTypes = (int*) calloc(count, sizeof(int));
+    _glfw.glx.configCount = 0;
+
+    if (!_glfw.glx.configs || !_glfw.glx.drawableTypes)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GL_FALSE;
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        _GLFWfbconfig* config = _glfw.glx.configs + _glfw.glx.configCount;
+        int drawableTypes = getFBConfigAttrib(native[i], GLX_DRAWABLE_TYPE);
+
+        // Windows need configs with an associated X visual
+        if (!getFBConfigAttrib(native[i], GLX_X_RENDERABLE))
+            drawableTypes &= ~GLX_WINDOW_BIT;
+
+        // Only consider double-buffered RGBA configs usable for windows or
+        // headless pbuffers
+        if (!(getFBConfigAttrib(native[i], GLX_RENDER_TYPE) & GLX_RGBA_BIT) ||
+            !(drawableTypes & (GLX_WINDOW_BIT | GLX_PBUFFER_BIT)) ||
+            !getFBConfigAttrib(native[i], GLX_DOUBLEBUFFER))
+        {
+            continue;
+        }
+
+        config->redBits = getFBConfigAttrib(native[i], GLX_RED_SIZE);
+        config->greenBits = getFBConfigAttrib(native[i], GLX_GREEN_SIZE);
+        config->blueBits = getFBConfigAttrib(native[i], GLX_BLUE_SIZE);
+
+        config->alphaBits = getFBConfigAttrib(native[i], GLX_ALPHA_SIZE);
+        config->depthBits = getFBConfigAttrib(native[i], GLX_DEPTH_SIZE);
+        config->stencilBits = getFBConfigAttrib(native[i], GLX_STENCIL_SIZE);
+
+        config->accumRedBits = getFBConfigAttrib(native[i], GLX_ACCUM_RED_SIZE);
+        config->accumGreenBits = getFBConfigAttrib(native[i], GLX_ACCUM_GREEN_SIZE);
+        config->accumBlueBits = getFBConfigAttrib(native[i], GLX_ACCUM_BLUE_SIZE);
+        config->accumAlphaBits = getFBConfigAttrib(native[i], GLX_ACCUM_ALPHA_SIZE);
+
+        config->auxBuffers = getFBConfigAttrib(native[i], GLX_AUX_BUFFERS);
+        config->stereo = getFBConfigAttrib(native[i], GLX_STEREO) ? GL_TRUE : GL_FALSE;
+
+        if (_glfw.glx.ARB_multisample)
+            config->samples = getFBConfigAttrib(native[i], GLX_SAMPLES_ARB);
+
+        if (_glfw.glx.ARB_framebuffer_sRGB)
+        {
+            config->sRGB =
+                getFBConfigAttrib(native[i], GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB) ?
+                GL_TRUE : GL_FALSE;
+        }
+
+        // Slow and non-conformant configs are only chosen over otherwise
+        // equal conformant ones as a last resort
+        {
+            const int caveat = getFBConfigAttrib(native[i], GLX_CONFIG_CAVEAT);
+            if (caveat == GLX_SLOW_CONFIG || caveat == GLX_NON_CONFORMANT_CONFIG)
+                config->slow = GL_TRUE;
+        }
+
+        // Compact the native array so that indices match the cached configs
+        native[_glfw.glx.configCount] = native[i];
+        _glfw.glx.drawableTypes[_glfw.glx.configCount] = drawableTypes;
+        _glfw.glx.configCount++;
+    }
+
+    return GL_TRUE;
+}
+
+// Returns the index of the cached GLXFBConfig that best matches the desired
+// one and supports the specified drawable type, or -1 if none does
+// Any error is reported here
+//
+static int chooseFBConfig(const _GLFWfbconfig* desired, int drawableType)
+{
+    int i, count = 0, result = -1;
+    _GLFWfbconfig* usable;
+    int* indices;
+    const _GLFWfbconfig* closest;
+
+    usable = (_GLFWfbconfig*) calloc(_glfw.glx.configCount,
+                                     sizeof(_GLFWfbconfig));
+    indices = (int*) calloc(_glfw.glx.configCount, sizeof(int));
+
+    if (_glfw.glx.configCount && (!usable || !indices))
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+
+        free(usable);
+        free(indices);
+        return -1;
+    }
+
+    for (i = 0;  i < _glfw.glx.configCount;  i++)
+    {
+        if (_glfw.glx.drawableTypes[i] & drawableType)
+        {
+            usable[count] = _glfw.glx.configs[i];
+            indices[count] = i;
+            count++;
+        }
+    }
+
+    closest = _glfwChooseFBConfig(desired, usable, count);
+    if (closest)
+        result = indices[closest - usable];
+    else
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "GLX: Failed to find a suitable GLXFBConfig");
+    }
+
+    free(usable);
+    free(indices);
+    return result;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -146,6 +326,14 @@ int _glfwInitContextAPI(void)
         return GL_FALSE;
     }
 
+    // Cache the GLX extensions once, as the server list does not change
+    {
+        const char* extensions = glXQueryExtensionsString(_glfw.x11.display,
+                                                          _glfw.x11.screen);
+        if (extensions != NULL)
+            _glfwAddExtensionString(&_glfw.glx.extensions, extensions);
+    }
+
     if (_glfwPlatformExtensionSupported("GLX_EXT_swap_control"))
     {
         _glfw.glx.SwapIntervalEXT = (PFNGLXSWAPINTERVALEXTPROC)
@@ -155,6 +343,9 @@ int _glfwInitContextAPI(void)
             _glfw.glx.EXT_swap_control = GL_TRUE;
     }
 
+    if (_glfwPlatformExtensionSupported("GLX_EXT_swap_control_tear"))
+        _glfw.glx.EXT_swap_control_tear = GL_TRUE;
+
     if (_glfwPlatformExtensionSupported("GLX_SGI_swap_control"))
     {
         _glfw.glx.SwapIntervalSGI = (PFNGLXSWAPINTERVALSGIPROC)
@@ -173,6 +364,11 @@ int _glfwInitContextAPI(void)
             _glfw.glx.MESA_swap_control = GL_TRUE;
     }
 
+#if defined(GLX_BufferSwapComplete)
+    if (_glfwPlatformExtensionSupported("GLX_INTEL_swap_event"))
+        _glfw.glx.INTEL_swap_event = GL_TRUE;
+#endif
+
     if (_glfwPlatformExtensionSupported("GLX_SGIX_fbconfig"))
     {
         _glfw.glx.GetFBConfigAttribSGIX = (PFNGLXGETFBCONFIGATTRIBSGIXPROC)
@@ -217,6 +413,9 @@ int _glfwInitContextAPI(void)
     if (_glfwPlatformExtensionSupported("GLX_EXT_create_context_es2_profile"))
         _glfw.glx.EXT_create_context_es2_profile = GL_TRUE;
 
+    if (!initFBConfigs())
+        return GL_FALSE;
+
     return GL_TRUE;
 }
 
@@ -224,6 +423,20 @@ int _glfwInitContextAPI(void)
 //
 void _glfwTerminateContextAPI(void)
 {
+    if (_glfw.glx.native)
+    {
+        XFree(_glfw.glx.native);
+        _glfw.glx.native = NULL;
+    }
+
+    free(_glfw.glx.configs);
+    _glfw.glx.configs = NULL;
+    free(_glfw.glx.drawableTypes);
+    _glfw.glx.drawableTypes = NULL;
+    _glfw.glx.configCount = 0;
+
+    _glfwFreeExtensionSet(&_glfw.glx.extensions);
+
     // Unload libGL.so if necessary
 #ifdef _GLFW_DLOPEN_LIBGL
     if (_glfw.glx.libGL != NULL)
@@ -248,117 +461,62 @@ int _glfwCreateContext(_GLFWwindow* window,
                        const _GLFWfbconfig* fbconfig)
 {
     int attribs[40];
-    GLXFBConfig* native;
+    GLXFBConfig native;
     GLXContext share = NULL;
 
     if (wndconfig->share)
         share = wndconfig->share->glx.context;
 
-    // Find a suitable GLXFBConfig
+    if (wndconfig->headless)
     {
-        int count, index = 0;
-
-        setGLXattrib(GLX_DOUBLEBUFFER, True);
-        setGLXattrib(GLX_X_RENDERABLE, True);
-
-        if (fbconfig->redBits)
-            setGLXattrib(GLX_RED_SIZE, fbconfig->redBits);
-        if (fbconfig->greenBits)
-            setGLXattrib(GLX_GREEN_SIZE, fbconfig->greenBits);
-        if (fbconfig->blueBits)
-            setGLXattrib(GLX_BLUE_SIZE, fbconfig->blueBits);
-        if (fbconfig->alphaBits)
-            setGLXattrib(GLX_ALPHA_SIZE, fbconfig->alphaBits);
-
-        if (fbconfig->depthBits)
-            setGLXattrib(GLX_DEPTH_SIZE, fbconfig->depthBits);
-        if (fbconfig->stencilBits)
-            setGLXattrib(GLX_STENCIL_SIZE, fbconfig->stencilBits);
-
-        if (fbconfig->auxBuffers)
-            setGLXattrib(GLX_AUX_BUFFERS, fbconfig->auxBuffers);
-
-        if (fbconfig->accumRedBits)
-            setGLXattrib(GLX_ACCUM_RED_SIZE, fbconfig->accumRedBits);
-        if (fbconfig->accumGreenBits)
-            setGLXattrib(GLX_ACCUM_GREEN_SIZE, fbconfig->accumGreenBits);
-        if (fbconfig->accumBlueBits)
-            setGLXattrib(GLX_ACCUM_BLUE_SIZE, fbconfig->accumBlueBits);
-        if (fbconfig->accumAlphaBits)
-            setGLXattrib(GLX_ACCUM_BLUE_SIZE, fbconfig->accumAlphaBits);
-
-        if (fbconfig->stereo)
-            setGLXattrib(GLX_STEREO, True);
-
-        if (_glfw.glx.ARB_multisample)
+        if (_glfw.glx.versionMajor == 1 && _glfw.glx.versionMinor < 3)
         {
-            if (fbconfig->samples)
-            {
-                setGLXattrib(GLX_SAMPLE_BUFFERS_ARB, 1);
-                setGLXattrib(GLX_SAMPLES_ARB, fbconfig->samples);
-            }
+            _glfwInputError(GLFW_API_UNAVAILABLE,
+                            "GLX: Headless contexts require GLX 1.3 pbuffers");
+            return GL_FALSE;
         }
+    }
 
-        if (_glfw.glx.ARB_framebuffer_sRGB)
-        {
-            if (fbconfig->sRGB)
-                setGLXattrib(GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB, True);
-        }
+    // Find the cached GLXFBConfig that best matches the desired one
+    {
+        int index;
 
-        setGLXattrib(None, None);
+        index = chooseFBConfig(fbconfig, wndconfig->headless ?
+                                         GLX_PBUFFER_BIT : GLX_WINDOW_BIT);
+        if (index < 0)
+            return GL_FALSE;
+
+        native = _glfw.glx.native[index];
+    }
 
+    // Retrieve the corresponding visual
+    if (!wndconfig->headless)
+    {
         if (_glfw.glx.SGIX_fbconfig)
         {
-            native = _glfw.glx.ChooseFBConfigSGIX(_glfw.x11.display,
-                                                  _glfw.x11.screen,
-                                                  attribs,
-                                                  &count);
+            window->glx.visual =
+                _glfw.glx.GetVisualFromFBConfigSGIX(_glfw.x11.display, native);
         }
         else
         {
-            native = glXChooseFBConfig(_glfw.x11.display,
-                                       _glfw.x11.screen,
-                                       attribs,
-                                       &count);
+            window->glx.visual = glXGetVisualFromFBConfig(_glfw.x11.display,
+                                                          native);
         }
 
-        if (native == NULL)
+        if (window->glx.visual == NULL)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "GLX: Failed to find a suitable GLXFBConfig");
+                            "GLX: Failed to retrieve visual for GLXFBConfig");
             return GL_FALSE;
         }
     }
 
-    // Retrieve the corresponding visual
-    if (_glfw.glx.SGIX_fbconfig)
-    {
-        window->glx.visual =
-            _glfw.glx.GetVisualFromFBConfigSGIX(_glfw.x11.display, *native);
-    }
-    else
-    {
-        window->glx.visual = glXGetVisualFromFBConfig(_glfw.x11.display,
-                                                      *native);
-    }
-
-    if (window->glx.visual == NULL)
-    {
-        XFree(native);
-
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "GLX: Failed to retrieve visual for GLXFBConfig");
-        return GL_FALSE;
-    }
-
     if (wndconfig->clientAPI == GLFW_OPENGL_ES_API)
     {
         if (!_glfw.glx.ARB_create_context ||
             !_glfw.glx.ARB_create_context_profile ||
             !_glfw.glx.EXT_create_context_es2_profile)
         {
-            XFree(native);
-
             _glfwInputError(GLFW_VERSION_UNAVAILABLE,
                             "GLX: OpenGL ES requested but "
                             "GLX_EXT_create_context_es2_profile is unavailable");
@@ -370,8 +528,6 @@ int _glfwCreateContext(_GLFWwindow* window,
     {
         if (!_glfw.glx.ARB_create_context)
         {
-            XFree(native);
-
             _glfwInputError(GLFW_VERSION_UNAVAILABLE,
                             "GLX: Forward compatibility requested but "
                             "GLX_ARB_create_context_profile is unavailable");
@@ -384,8 +540,6 @@ int _glfwCreateContext(_GLFWwindow* window,
         if (!_glfw.glx.ARB_create_context ||
             !_glfw.glx.ARB_create_context_profile)
         {
-            XFree(native);
-
             _glfwInputError(GLFW_VERSION_UNAVAILABLE,
                             "GLX: An OpenGL profile requested but "
                             "GLX_ARB_create_context_profile is unavailable");
@@ -455,7 +609,7 @@ int _glfwCreateContext(_GLFWwindow* window,
 
         window->glx.context =
             _glfw.glx.CreateContextAttribsARB(_glfw.x11.display,
-                                              *native,
+                                              native,
                                               share,
                                               True,
                                               attribs);
@@ -470,17 +624,15 @@ int _glfwCreateContext(_GLFWwindow* window,
                 wndconfig->glProfile == GLFW_OPENGL_NO_PROFILE &&
                 wndconfig->glForward == GL_FALSE)
             {
-                window->glx.context = createLegacyContext(window, *native, share);
+                window->glx.context = createLegacyContext(window, native, share);
             }
         }
     }
     else
-        window->glx.context = createLegacyContext(window, *native, share);
+        window->glx.context = createLegacyContext(window, native, share);
 
     XSetErrorHandler(NULL);
 
-    XFree(native);
-
     if (window->glx.context == NULL)
     {
         char buffer[8192];
@@ -495,6 +647,50 @@ int _glfwCreateContext(_GLFWwindow* window,
         return GL_FALSE;
     }
 
+    if (wndconfig->headless)
+    {
+        int index = 0;
+
+        setGLXattrib(GLX_PBUFFER_WIDTH, wndconfig->width);
+        setGLXattrib(GLX_PBUFFER_HEIGHT, wndconfig->height);
+        setGLXattrib(GLX_PRESERVED_CONTENTS, True);
+        setGLXattrib(None, None);
+
+        // GLX reports pbuffer creation failures as X errors, which need to be
+        // caught before they reach the default handler
+        _glfwErrorCode = Success;
+        XSetErrorHandler(errorHandler);
+
+        window->glx.pbuffer = glXCreatePbuffer(_glfw.x11.display,
+                                               native,
+                                               attribs);
+        XSync(_glfw.x11.display, False);
+
+        XSetErrorHandler(NULL);
+
+        if (!window->glx.pbuffer || _glfwErrorCode != Success)
+        {
+            char buffer[8192];
+            XGetErrorText(_glfw.x11.display,
+                          _glfwErrorCode,
+                          buffer, sizeof(buffer));
+
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "GLX: Failed to create pbuffer: %s",
+                            buffer);
+
+            if (window->glx.pbuffer)
+            {
+                glXDestroyPbuffer(_glfw.x11.display, window->glx.pbuffer);
+                window->glx.pbuffer = None;
+            }
+
+            glXDestroyContext(_glfw.x11.display, window->glx.context);
+            window->glx.context = NULL;
+            return GL_FALSE;
+        }
+    }
+
     return GL_TRUE;
 }
 
@@ -510,6 +706,12 @@ void _glfwDestroyContext(_GLFWwindow* window)
         window->glx.visual = NULL;
     }
 
+    if (window->glx.pbuffer)
+    {
+        glXDestroyPbuffer(_glfw.x11.display, window->glx.pbuffer);
+        window->glx.pbuffer = None;
+    }
+
     if (window->glx.context)
     {
         glXDestroyContext(_glfw.x11.display, window->glx.context);
@@ -517,6 +719,57 @@ void _glfwDestroyContext(_GLFWwindow* window)
     }
 }
 
+// Requests swap completion events for the specified window
+// Returns GL_FALSE if they are not supported
+//
+GLboolean _glfwSelectSwapEvents(_GLFWwindow* window)
+{
+#if defined(GLX_BufferSwapComplete)
+    if (!_glfw.glx.INTEL_swap_event)
+        return GL_FALSE;
+
+    // The event mask is selected when the context is first made current, as
+    // some implementations (like Mesa with DRI2) keep it with the GLX drawable
+    // state, which does not exist before then
+    window->glx.selectSwapEvents = GL_TRUE;
+    return GL_TRUE;
+#else
+    return GL_FALSE;
+#endif // GLX_BufferSwapComplete
+}
+
+// Reports the presentation of a buffer swap if the specified event is a swap
+// completion event
+//
+GLboolean _glfwHandleSwapEvent(XEvent* event)
+{
+#if defined(GLX_BufferSwapComplete)
+    const GLXBufferSwapComplete* e = (const GLXBufferSwapComplete*) event;
+    _GLFWwindow* window;
+
+    if (!_glfw.glx.INTEL_swap_event ||
+        event->type != _glfw.glx.eventBase + GLX_BufferSwapComplete)
+    {
+        return GL_FALSE;
+    }
+
+    window = _glfwFindWindowByHandle(e->drawable);
+    if (window)
+    {
+        // The UST is in microseconds of the monotonic clock
+        _glfwInputWindowPresent(window,
+                                (uint64_t) e->sbc,
+                                (uint64_t) e->msc,
+                                _glfwTranslateClockTime((long) (e->ust / 1000000),
+                                                        (long) (e->ust % 1000000)));
+    }
+
+    return GL_TRUE;
+#else
+    return GL_FALSE;
+#endif // GLX_BufferSwapComplete
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -526,9 +779,29 @@ void _glfwPlatformMakeContextCurrent(_GLFWwindow* window)
 {
     if (window)
     {
-        glXMakeCurrent(_glfw.x11.display,
-                       window->x11.handle,
-                       window->glx.context);
+        if (window->glx.pbuffer)
+        {
+            // Pbuffers can only be made current through the GLX 1.3 function
+            glXMakeContextCurrent(_glfw.x11.display,
+                                  window->glx.pbuffer,
+                                  window->glx.pbuffer,
+                                  window->glx.context);
+        }
+        else
+        {
+            glXMakeCurrent(_glfw.x11.display,
+                           window->x11.handle,
+                           window->glx.context);
+
+#if defined(GLX_BufferSwapComplete)
+            if (window->glx.selectSwapEvents)
+            {
+                glXSelectEvent(_glfw.x11.display, window->x11.handle,
+                               GLX_BUFFER_SWAP_COMPLETE_INTEL_MASK);
+                window->glx.selectSwapEvents = GL_FALSE;
+            }
+#endif // GLX_BufferSwapComplete
+        }
     }
     else
         glXMakeCurrent(_glfw.x11.display, None, NULL);
@@ -543,17 +816,25 @@ _GLFWwindow* _glfwPlatformGetCurrentContext(void)
 
 void _glfwPlatformSwapBuffers(_GLFWwindow* window)
 {
-    glXSwapBuffers(_glfw.x11.display, window->x11.handle);
+    glXSwapBuffers(_glfw.x11.display, getDrawable(window));
 }
 
 void _glfwPlatformSwapInterval(int interval)
 {
     _GLFWwindow* window = _glfwCurrentWindow;
 
+    // Negative intervals request late swaps to tear, which only
+    // GLX_EXT_swap_control_tear (through glXSwapIntervalEXT) supports
+    if (interval < 0 &&
+        !(_glfw.glx.EXT_swap_control && _glfw.glx.EXT_swap_control_tear))
+    {
+        interval = -interval;
+    }
+
     if (_glfw.glx.EXT_swap_control)
     {
         _glfw.glx.SwapIntervalEXT(_glfw.x11.display,
-                                  window->x11.handle,
+                                  getDrawable(window),
                                   interval);
     }
     else if (_glfw.glx.MESA_swap_control)
@@ -567,18 +848,7 @@ void _glfwPlatformSwapInterval(int interval)
 
 int _glfwPlatformExtensionSupported(const char* extension)
 {
-    const GLubyte* extensions;
-
-    // Get list of GLX extensions
-    extensions = (const GLubyte*) glXQueryExtensionsString(_glfw.x11.display,
-                                                           _glfw.x11.screen);
-    if (extensions != NULL)
-    {
-        if (_glfwStringInExtensionString(extension, extensions))
-            return GL_TRUE;
-    }
-
-    return GL_FALSE;
+    return _glfwExtensionInSet(&_glfw.glx.extensions, extension);
 }
 
 GLFWglproc _glfwPlatformGetProcAddress(const char* procname)
@@ -79,6 +79,8 @@ typedef struct _GLFWcontextGLX
 {
     GLXContext      context; // OpenGL rendering context
     XVisualInfo*    visual;  // Visual for selected GLXFBConfig
+    GLXPbuffer      pbuffer; // Offscreen drawable of headless contexts
+    GLboolean       selectSwapEvents; // Select swap events when next current
 
 } _GLFWcontextGLX;
 
@@ -94,6 +96,7 @@ typedef struct _GLFWlibraryGLX
     int             errorBase;
 
     // GLX extensions
+    _GLFWextset     extensions;
     PFNGLXSWAPINTERVALSGIPROC             SwapIntervalSGI;
     PFNGLXSWAPINTERVALEXTPROC             SwapIntervalEXT;
     PFNGLXSWAPINTERVALMESAPROC            SwapIntervalMESA;
@@ -105,7 +108,9 @@ typedef struct _GLFWlibraryGLX
     GLboolean       SGIX_fbconfig;
     GLboolean       SGI_swap_control;
     GLboolean       EXT_swap_control;
+    GLboolean       EXT_swap_control_tear;
     GLboolean       MESA_swap_control;
+    GLboolean       INTEL_swap_event;
     GLboolean       ARB_multisample;
     GLboolean       ARB_framebuffer_sRGB;
     GLboolean       ARB_create_context;
@@ -113,6 +118,12 @@ typedef struct _GLFWlibraryGLX
     GLboolean       ARB_create_context_robustness;
     GLboolean       EXT_create_context_es2_profile;
 
+    // Cached framebuffer configs, with configs[i] describing native[i]
+    GLXFBConfig*    native;
+    _GLFWfbconfig*  configs;
+    int*            drawableTypes;
+    int             configCount;
+
 #if defined(_GLFW_DLOPEN_LIBGL)
     void*           libGL;  // dlopen handle for libGL.so
 #endif
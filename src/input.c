@@ -30,6 +30,9 @@
 
 #include "internal.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 
 // Sets the cursor mode for the specified window
 //
@@ -49,6 +52,13 @@ static void setCursorMode(_GLFWwindow* window, int newMode)
     if (oldMode == newMode)
         return;
 
+    if (window->headless)
+    {
+        // There is no cursor to change for a headless window
+        window->cursorMode = newMode;
+        return;
+    }
+
     _glfwPlatformGetWindowSize(window, &width, &height);
 
     centerPosX = width / 2;
@@ -108,6 +118,62 @@ static void setStickyMouseButtons(_GLFWwindow* window, int enabled)
     window->stickyMouseButtons = enabled;
 }
 
+// Enable or disable the event queue for the specified window
+//
+static void setEventQueue(_GLFWwindow* window, int enabled)
+{
+    if (enabled)
+    {
+        if (window->queue.events)
+            return;
+
+        window->queue.events = (GLFWevent*) calloc(_GLFW_EVENT_QUEUE_SIZE,
+                                                   sizeof(GLFWevent));
+        if (!window->queue.events)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+    }
+    else
+    {
+        free(window->queue.events);
+        window->queue.events = NULL;
+    }
+
+    window->queue.head = 0;
+    window->queue.count = 0;
+}
+
+// Returns a cleared slot at the tail of the event queue of the specified
+// window, or NULL if the window has no event queue
+//
+static GLFWevent* queueEvent(_GLFWwindow* window, int type)
+{
+    GLFWevent* event;
+
+    if (!window->queue.events)
+        return NULL;
+
+    if (window->queue.count == _GLFW_EVENT_QUEUE_SIZE)
+    {
+        // The queue is full, so discard the oldest event
+        window->queue.head = (window->queue.head + 1) % _GLFW_EVENT_QUEUE_SIZE;
+        window->queue.count--;
+    }
+
+    event = window->queue.events +
+            (window->queue.head + window->queue.count) % _GLFW_EVENT_QUEUE_SIZE;
+    window->queue.count++;
+
+    memset(event, 0, sizeof(GLFWevent));
+    event->type = type;
+    event->window = (GLFWwindow*) window;
+    event->time = _glfw.eventTime;
+
+    return event;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -115,6 +181,7 @@ static void setStickyMouseButtons(_GLFWwindow* window, int enabled)
 
 void _glfwInputKey(_GLFWwindow* window, int key, int action)
 {
+    GLFWevent* event;
     GLboolean repeated = GL_FALSE;
 
     if (key < 0 || key > GLFW_KEY_LAST)
@@ -131,28 +198,50 @@ void _glfwInputKey(_GLFWwindow* window, int key, int action)
     if (repeated)
         action = GLFW_REPEAT;
 
+    event = queueEvent(window, GLFW_KEY_EVENT);
+    if (event)
+    {
+        event->key = key;
+        event->action = action;
+    }
+
     if (window->callbacks.key)
         window->callbacks.key((GLFWwindow*) window, key, action);
 }
 
 void _glfwInputChar(_GLFWwindow* window, int character)
 {
+    GLFWevent* event;
+
     // Valid Unicode (ISO 10646) character?
     if (!((character >= 32 && character <= 126) || character >= 160))
         return;
 
+    event = queueEvent(window, GLFW_CHAR_EVENT);
+    if (event)
+        event->character = character;
+
     if (window->callbacks.character)
         window->callbacks.character((GLFWwindow*) window, character);
 }
 
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
 {
+    GLFWevent* event = queueEvent(window, GLFW_SCROLL_EVENT);
+    if (event)
+    {
+        event->xoffset = xoffset;
+        event->yoffset = yoffset;
+    }
+
     if (window->callbacks.scroll)
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
 }
 
 void _glfwInputMouseClick(_GLFWwindow* window, int button, int action)
 {
+    GLFWevent* event;
+
     if (button < 0 || button > GLFW_MOUSE_BUTTON_LAST)
         return;
 
@@ -162,12 +251,21 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action)
     else
         window->mouseButton[button] = (char) action;
 
+    event = queueEvent(window, GLFW_MOUSE_BUTTON_EVENT);
+    if (event)
+    {
+        event->button = button;
+        event->action = action;
+    }
+
     if (window->callbacks.mouseButton)
         window->callbacks.mouseButton((GLFWwindow*) window, button, action);
 }
 
 void _glfwInputCursorMotion(_GLFWwindow* window, int x, int y)
 {
+    GLFWevent* event;
+
     if (window->cursorMode == GLFW_CURSOR_CAPTURED)
     {
         if (!x && !y)
@@ -185,6 +283,13 @@ void _glfwInputCursorMotion(_GLFWwindow* window, int x, int y)
         window->cursorPosY = y;
     }
 
+    event = queueEvent(window, GLFW_CURSOR_POS_EVENT);
+    if (event)
+    {
+        event->xpos = window->cursorPosX;
+        event->ypos = window->cursorPosY;
+    }
+
     if (window->callbacks.cursorPos)
     {
         window->callbacks.cursorPos((GLFWwindow*) window,
@@ -195,6 +300,10 @@ void _glfwInputCursorMotion(_GLFWwindow* window, int x, int y)
 
 void _glfwInputCursorEnter(_GLFWwindow* window, int entered)
 {
+    GLFWevent* event = queueEvent(window, GLFW_CURSOR_ENTER_EVENT);
+    if (event)
+        event->entered = entered;
+
     if (window->callbacks.cursorEnter)
         window->callbacks.cursorEnter((GLFWwindow*) window, entered);
 }
@@ -218,6 +327,10 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* handle, int mode)
             return window->stickyKeys;
         case GLFW_STICKY_MOUSE_BUTTONS:
             return window->stickyMouseButtons;
+        case GLFW_COALESCE_EVENTS:
+            return window->coalesceEvents;
+        case GLFW_EVENT_QUEUE:
+            return window->queue.events != NULL;
         default:
             _glfwInputError(GLFW_INVALID_ENUM, NULL);
             return 0;
@@ -241,6 +354,12 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
         case GLFW_STICKY_MOUSE_BUTTONS:
             setStickyMouseButtons(window, value ? GL_TRUE : GL_FALSE);
             break;
+        case GLFW_COALESCE_EVENTS:
+            window->coalesceEvents = value ? GL_TRUE : GL_FALSE;
+            break;
+        case GLFW_EVENT_QUEUE:
+            setEventQueue(window, value ? GL_TRUE : GL_FALSE);
+            break;
         default:
             _glfwInputError(GLFW_INVALID_ENUM, NULL);
             break;
@@ -372,3 +491,30 @@ GLFWAPI void glfwSetScrollCallback(GLFWwindow* handle, GLFWscrollfun cbfun)
     window->callbacks.scroll = cbfun;
 }
 
+GLFWAPI int glfwGetEvents(GLFWwindow* handle, GLFWevent* events, int maxevents)
+{
+    int i, count;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (maxevents < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid event count");
+        return 0;
+    }
+
+    count = window->queue.count;
+    if (count > maxevents)
+        count = maxevents;
+
+    for (i = 0;  i < count;  i++)
+    {
+        events[i] = window->queue.events[window->queue.head];
+        window->queue.head = (window->queue.head + 1) % _GLFW_EVENT_QUEUE_SIZE;
+    }
+
+    window->queue.count -= count;
+    return count;
+}
+
@@ -63,6 +63,21 @@ typedef struct _GLFWfbconfig    _GLFWfbconfig;
 typedef struct _GLFWwindow      _GLFWwindow;
 typedef struct _GLFWlibrary     _GLFWlibrary;
 typedef struct _GLFWmonitor     _GLFWmonitor;
+typedef struct _GLFWextset      _GLFWextset;
+
+/*! @brief Hashed set of extension or function names.
+ *
+ *  This is defined before the platform headers are included, as their context
+ *  API state embeds one for the platform-specific extensions.  The entry point
+ *  cache of each context uses the same table, with an entry point per name.
+ */
+struct _GLFWextset
+{
+    char**          names;  // Open addressing table, NULL for empty slots
+    GLFWglproc*     procs;  // Entry point of each slot, or NULL if not cached
+    unsigned int    size;   // Table size, always zero or a power of two
+    unsigned int    count;
+};
 
 #if defined(_GLFW_COCOA)
  #include "cocoa_platform.h"
@@ -109,6 +124,9 @@ typedef struct _GLFWmonitor     _GLFWmonitor;
 // Internal key state used for sticky keys
 #define _GLFW_STICK 3
 
+// Number of events held by a window event queue
+#define _GLFW_EVENT_QUEUE_SIZE 1024
+
 // Checks for whether the library has been intitalized
 #define _GLFW_REQUIRE_INIT()                         \
     if (!_glfwInitialized)                           \
@@ -149,6 +167,7 @@ struct _GLFWhints
     GLboolean   stereo;
     GLboolean   resizable;
     GLboolean   visible;
+    GLboolean   headless;
     int         samples;
     GLboolean   sRGB;
     int         clientAPI;
@@ -174,6 +193,7 @@ struct _GLFWwndconfig
     const char*   title;
     GLboolean     resizable;
     GLboolean     visible;
+    GLboolean     headless;
     int           clientAPI;
     int           glMajor;
     int           glMinor;
@@ -207,6 +227,7 @@ struct _GLFWfbconfig
     GLboolean   stereo;
     int         samples;
     GLboolean   sRGB;
+    GLboolean   slow;   // Slow or non-conformant, only set for alternatives
 };
 
 
@@ -221,6 +242,8 @@ struct _GLFWwindow
     GLboolean           resizable;
     GLboolean           visible;
     GLboolean           closed;
+    GLboolean           headless;
+    int                 headlessWidth, headlessHeight;
     void*               userPointer;
     GLFWvidmode         videoMode;
     _GLFWmonitor*       monitor;
@@ -228,17 +251,30 @@ struct _GLFWwindow
     // Window input state
     GLboolean           stickyKeys;
     GLboolean           stickyMouseButtons;
+    GLboolean           coalesceEvents;
     int                 cursorPosX, cursorPosY;
     int                 cursorMode;
     char                mouseButton[GLFW_MOUSE_BUTTON_LAST + 1];
     char                key[GLFW_KEY_LAST + 1];
 
+    // Input event queue, allocated when enabled
+    struct {
+        GLFWevent*      events;
+        int             head;
+        int             count;
+    } queue;
+
     // OpenGL extensions and context attributes
     int                 clientAPI;
     int                 glMajor, glMinor, glRevision;
     GLboolean           glForward, glDebug;
     int                 glProfile;
     int                 glRobustness;
+    _GLFWextset         extensions;
+
+    // Client API entry points resolved for this context
+    _GLFWextset         procs;
+
 #if defined(_GLFW_USE_OPENGL)
     PFNGLGETSTRINGIPROC GetStringi;
 #endif
@@ -248,6 +284,7 @@ struct _GLFWwindow
         GLFWwindowsizefun    size;
         GLFWwindowclosefun   close;
         GLFWwindowrefreshfun refresh;
+        GLFWwindowpresentfun present;
         GLFWwindowfocusfun   focus;
         GLFWwindowiconifyfun iconify;
         GLFWmousebuttonfun   mouseButton;
@@ -294,10 +331,18 @@ struct _GLFWlibrary
     _GLFWwindow*    windowListHead;
     _GLFWwindow*    focusedWindow;
 
+    // Time of the event currently being processed, set by the platform code
+    double          eventTime;
+
+    // Maximum time to wait for the clipboard contents, or zero for no limit
+    double          clipboardTimeout;
+
     _GLFWmonitor**  monitors;
     int             monitorCount;
     GLFWmonitorfun  monitorCallback;
 
+    GLFWjoystickfun joystickCallback;
+
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_LIBRARY_WINDOW_STATE;
     // This is defined in the context API's platform.h
@@ -398,6 +443,16 @@ void _glfwPlatformSetClipboardString(_GLFWwindow* window, const char* string);
  */
 const char* _glfwPlatformGetClipboardString(_GLFWwindow* window);
 
+/*! @copydoc glfwRequestClipboardString
+ *  @ingroup platform
+ */
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window, GLFWclipboardfun cbfun);
+
+/*! @copydoc glfwRequestClipboardStream
+ *  @ingroup platform
+ */
+void _glfwPlatformRequestClipboardStream(_GLFWwindow* window, GLFWclipboardstreamfun cbfun);
+
 /*! @copydoc glfwGetJoystickParam
  *  @ingroup platform
  */
@@ -418,6 +473,16 @@ int _glfwPlatformGetJoystickButtons(int joy, unsigned char* buttons, int numbutt
  */
 const char* _glfwPlatformGetJoystickName(int joy);
 
+/*! @copydoc glfwGetJoystickEvents
+ *  @ingroup platform
+ */
+int _glfwPlatformGetJoystickEvents(int joy, GLFWjoystickevent* events, int maxevents);
+
+/*! @copydoc glfwSetJoystickThread
+ *  @ingroup platform
+ */
+void _glfwPlatformSetJoystickThread(int enabled);
+
 /*! @copydoc glfwGetTime
  *  @ingroup platform
  */
@@ -428,6 +493,21 @@ double _glfwPlatformGetTime(void);
  */
 void _glfwPlatformSetTime(double time);
 
+/*! @copydoc glfwGetTimerValue
+ *  @ingroup platform
+ */
+uint64_t _glfwPlatformGetTimerValue(void);
+
+/*! @copydoc glfwGetTimerFrequency
+ *  @ingroup platform
+ */
+uint64_t _glfwPlatformGetTimerFrequency(void);
+
+/*! @copydoc glfwWaitUntil
+ *  @ingroup platform
+ */
+void _glfwPlatformWaitUntil(double time);
+
 /*! @ingroup platform
  */
 int _glfwPlatformCreateWindow(_GLFWwindow* window,
@@ -498,6 +578,16 @@ void _glfwPlatformPollEvents(void);
  */
 void _glfwPlatformWaitEvents(void);
 
+/*! @copydoc glfwWaitEventsTimeout
+ *  @ingroup platform
+ */
+void _glfwPlatformWaitEventsTimeout(double timeout);
+
+/*! @copydoc glfwPostEmptyEvent
+ *  @ingroup platform
+ */
+void _glfwPlatformPostEmptyEvent(void);
+
 /*! @copydoc glfwMakeContextCurrent
  *  @ingroup platform
  */
@@ -577,6 +667,16 @@ void _glfwInputWindowVisibility(_GLFWwindow* window, int visible);
  */
 void _glfwInputWindowDamage(_GLFWwindow* window);
 
+/*! @brief Notifies shared code that a buffer swap of a window was presented.
+ *  @param[in] window The window whose buffer swap was presented.
+ *  @param[in] count The number of buffer swaps completed so far.
+ *  @param[in] msc The vertical retrace counter at presentation.
+ *  @param[in] time The time of presentation.
+ *  @ingroup event
+ */
+void _glfwInputWindowPresent(_GLFWwindow* window,
+                             uint64_t count, uint64_t msc, double time);
+
 /*! @brief Notifies shared code of a window close request event
  *  @param[in] window The window that received the event.
  *  @ingroup event
@@ -636,6 +736,13 @@ void _glfwInputCursorEnter(_GLFWwindow* window, int entered);
  */
 void _glfwInputMonitorChange(void);
 
+/*! @brief Notifies shared code of a joystick connection or disconnection.
+ *  @param[in] joy The joystick that was connected or disconnected.
+ *  @param[in] event One of @c GLFW_CONNECTED or @c GLFW_DISCONNECTED.
+ *  @ingroup event
+ */
+void _glfwInputJoystickChange(int joy, int event);
+
 /*! @brief Notifies shared code of an error.
  *  @param[in] error The error code most suitable for the error.
  *  @param[in] format The @c printf style format string of the error
@@ -672,6 +779,39 @@ void _glfwSplitBPP(int bpp, int* red, int* green, int* blue);
  */
 int _glfwStringInExtensionString(const char* string, const GLubyte* extensions);
 
+/*! @brief Chooses the framebuffer config that best matches the desired one.
+ *  @param[in] desired The desired framebuffer config.
+ *  @param[in] alternatives The framebuffer configs supported by the system.
+ *  @param[in] count The number of entries in the alternatives array.
+ *  @return The framebuffer config most closely matching the desired one, or @c
+ *  NULL if none fulfilled the hard constraints of the desired values.
+ *  @ingroup utility
+ */
+const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
+                                         const _GLFWfbconfig* alternatives,
+                                         unsigned int count);
+
+/*! @brief Adds every extension in an extension string to an extension set.
+ *  @param[in] set The extension set to add to.
+ *  @param[in] string The space-separated list of extension names to add.
+ *  @ingroup utility
+ */
+void _glfwAddExtensionString(_GLFWextset* set, const char* string);
+
+/*! @brief Checks whether an extension set contains the specified extension.
+ *  @param[in] set The extension set to search.
+ *  @param[in] name The extension to search for.
+ *  @return @c GL_TRUE if the extension was found, or @c GL_FALSE otherwise.
+ *  @ingroup utility
+ */
+GLboolean _glfwExtensionInSet(const _GLFWextset* set, const char* name);
+
+/*! @brief Frees all memory used by an extension set and clears it.
+ *  @param[in] set The extension set to free.
+ *  @ingroup utility
+ */
+void _glfwFreeExtensionSet(_GLFWextset* set);
+
 /*! @brief Checks and reads back properties from the current context.
  *  @return @c GL_TRUE if successful, or @c GL_FALSE if the context is unusable.
  *  @ingroup utility
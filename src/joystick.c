@@ -31,6 +31,17 @@
 #include "internal.h"
 
 
+//////////////////////////////////////////////////////////////////////////
+//////                         GLFW event API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+void _glfwInputJoystickChange(int joy, int event)
+{
+    if (_glfw.joystickCallback)
+        _glfw.joystickCallback(joy, event);
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -113,3 +124,34 @@ GLFWAPI const char* glfwGetJoystickName(int joy)
     return _glfwPlatformGetJoystickName(joy);
 }
 
+GLFWAPI int glfwGetJoystickEvents(int joy, GLFWjoystickevent* events, int maxevents)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (joy < 0 || joy > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, NULL);
+        return 0;
+    }
+
+    if (events == NULL || maxevents < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, NULL);
+        return 0;
+    }
+
+    return _glfwPlatformGetJoystickEvents(joy, events, maxevents);
+}
+
+GLFWAPI void glfwSetJoystickCallback(GLFWjoystickfun cbfun)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfw.joystickCallback = cbfun;
+}
+
+GLFWAPI void glfwSetJoystickThread(int enabled)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfwPlatformSetJoystickThread(enabled ? GL_TRUE : GL_FALSE);
+}
+
@@ -260,7 +260,8 @@ void _glfwPlatformSwapInterval(int interval)
 {
     _GLFWwindow* window = _glfwPlatformGetCurrentContext();
 
-    GLint sync = interval;
+    // There is no adaptive swap interval, so the magnitude is used instead
+    GLint sync = interval < 0 ? -interval : interval;
     [window->nsgl.context setValues:&sync forParameter:NSOpenGLCPSwapInterval];
 }
 
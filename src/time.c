@@ -47,3 +47,27 @@ GLFWAPI void glfwSetTime(double time)
     _glfwPlatformSetTime(time);
 }
 
+GLFWAPI uint64_t glfwGetTimerValue(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+    return _glfwPlatformGetTimerValue();
+}
+
+GLFWAPI uint64_t glfwGetTimerFrequency(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+    return _glfwPlatformGetTimerFrequency();
+}
+
+GLFWAPI void glfwWaitUntil(double time)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfwPlatformWaitUntil(time);
+}
+
+GLFWAPI double glfwGetEventTime(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0.0);
+    return _glfw.eventTime;
+}
+
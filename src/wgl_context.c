@@ -75,6 +75,7 @@ static void initWGLExtensions(_GLFWwindow* window)
     window->wgl.EXT_create_context_es2_profile = GL_FALSE;
     window->wgl.ARB_create_context_robustness = GL_FALSE;
     window->wgl.EXT_swap_control = GL_FALSE;
+    window->wgl.EXT_swap_control_tear = GL_FALSE;
     window->wgl.ARB_pixel_format = GL_FALSE;
 
     window->wgl.GetExtensionsStringEXT = (PFNWGLGETEXTENSIONSSTRINGEXTPROC)
@@ -130,6 +131,9 @@ static void initWGLExtensions(_GLFWwindow* window)
             window->wgl.EXT_swap_control = GL_TRUE;
     }
 
+    if (_glfwPlatformExtensionSupported("WGL_EXT_swap_control_tear"))
+        window->wgl.EXT_swap_control_tear = GL_TRUE;
+
     if (_glfwPlatformExtensionSupported("WGL_ARB_pixel_format"))
     {
         window->wgl.ChoosePixelFormatARB = (PFNWGLCHOOSEPIXELFORMATARBPROC)
@@ -533,6 +537,11 @@ void _glfwPlatformSwapInterval(int interval)
 {
     _GLFWwindow* window = _glfwCurrentWindow;
 
+    // Negative intervals request late swaps to tear, which requires
+    // WGL_EXT_swap_control_tear
+    if (interval < 0 && !window->wgl.EXT_swap_control_tear)
+        interval = -interval;
+
     if (window->wgl.EXT_swap_control)
         window->wgl.SwapIntervalEXT(interval);
 }
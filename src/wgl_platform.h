@@ -61,6 +61,7 @@ typedef struct _GLFWcontextWGL
     PFNWGLGETEXTENSIONSSTRINGARBPROC    GetExtensionsStringARB;
     PFNWGLCREATECONTEXTATTRIBSARBPROC   CreateContextAttribsARB;
     GLboolean                           EXT_swap_control;
+    GLboolean                           EXT_swap_control_tear;
     GLboolean                           ARB_multisample;
     GLboolean                           ARB_framebuffer_sRGB;
     GLboolean                           ARB_pixel_format;
@@ -238,3 +238,14 @@ const char* _glfwPlatformGetJoystickName(int joy)
     return _glfw.win32.joystick[i].name;
 }
 
+int _glfwPlatformGetJoystickEvents(int joy, GLFWjoystickevent* events, int maxevents)
+{
+    // The joystick API only provides the current state
+    return 0;
+}
+
+void _glfwPlatformSetJoystickThread(int enabled)
+{
+    // The joystick API reads the current state directly
+}
+
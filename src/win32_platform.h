@@ -164,6 +164,7 @@ typedef struct _GLFWlibraryWin32
     // Timer data
     struct {
         GLboolean       hasPC;
+        uint64_t        frequency;
         double          resolution;
         unsigned int    t0_32;
         __int64         t0_64;
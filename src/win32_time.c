@@ -44,12 +44,14 @@ void _glfwInitTimer(void)
     if (QueryPerformanceFrequency((LARGE_INTEGER*) &freq))
     {
         _glfw.win32.timer.hasPC = GL_TRUE;
+        _glfw.win32.timer.frequency = (uint64_t) freq;
         _glfw.win32.timer.resolution = 1.0 / (double) freq;
         QueryPerformanceCounter((LARGE_INTEGER*) &_glfw.win32.timer.t0_64);
     }
     else
     {
         _glfw.win32.timer.hasPC = GL_FALSE;
+        _glfw.win32.timer.frequency = 1000;
         _glfw.win32.timer.resolution = 0.001; // winmm resolution is 1 ms
         _glfw.win32.timer.t0_32 = _glfw_timeGetTime();
     }
@@ -89,3 +91,35 @@ void _glfwPlatformSetTime(double t)
         _glfw.win32.timer.t0_32 = _glfw_timeGetTime() - (int)(t * 1000.0);
 }
 
+uint64_t _glfwPlatformGetTimerValue(void)
+{
+    if (_glfw.win32.timer.hasPC)
+    {
+        __int64 value;
+        QueryPerformanceCounter((LARGE_INTEGER*) &value);
+        return (uint64_t) value;
+    }
+    else
+        return (uint64_t) _glfw_timeGetTime();
+}
+
+uint64_t _glfwPlatformGetTimerFrequency(void)
+{
+    return _glfw.win32.timer.frequency;
+}
+
+void _glfwPlatformWaitUntil(double time)
+{
+    for (;;)
+    {
+        const double remaining = time - _glfwPlatformGetTime();
+        if (remaining <= 0.0)
+            return;
+
+        // Sleep only leaves the thread when the scheduler runs, so the last
+        // few milliseconds are waited for actively
+        if (remaining > 0.002)
+            Sleep((DWORD) ((remaining - 0.002) * 1000.0));
+    }
+}
+
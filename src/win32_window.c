@@ -302,6 +302,10 @@ static LRESULT CALLBACK windowProc(HWND hWnd, UINT uMsg,
 {
     _GLFWwindow* window = (_GLFWwindow*) GetWindowLongPtr(hWnd, 0);
 
+    // Messages carry only a low-resolution tick count, so the event time is
+    // taken to be when the message is received
+    _glfw.eventTime = _glfwPlatformGetTime();
+
     switch (uMsg)
     {
         case WM_CREATE:
@@ -760,6 +764,13 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 {
     int status;
 
+    if (wndconfig->headless)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "Win32: Headless windows are not supported");
+        return GL_FALSE;
+    }
+
     if (!_glfw.win32.classAtom)
     {
         _glfw.win32.classAtom = registerWindowClass();
@@ -1166,6 +1177,30 @@ void _glfwPlatformWaitEvents(void)
     _glfwPlatformPollEvents();
 }
 
+void _glfwPlatformWaitEventsTimeout(double timeout)
+{
+    DWORD milliseconds = INFINITE - 1;
+
+    // Converting timeouts beyond the range of DWORD is undefined, and
+    // INFINITE itself would never time out
+    if (timeout * 1e3 < (double) (INFINITE - 1))
+        milliseconds = (DWORD) (timeout * 1e3);
+
+    MsgWaitForMultipleObjects(0, NULL, FALSE, milliseconds, QS_ALLEVENTS);
+
+    _glfwPlatformPollEvents();
+}
+
+void _glfwPlatformPostEmptyEvent(void)
+{
+    // Any window will do, as all windows are serviced by the same thread
+    _GLFWwindow* window = _glfw.windowListHead;
+    if (!window)
+        return;
+
+    PostMessage(window->win32.handle, WM_NULL, 0, 0);
+}
+
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, int xpos, int ypos)
 {
     POINT pos = { xpos, ypos };
@@ -124,6 +124,13 @@ void _glfwInputWindowDamage(_GLFWwindow* window)
         window->callbacks.refresh((GLFWwindow*) window);
 }
 
+void _glfwInputWindowPresent(_GLFWwindow* window,
+                             uint64_t count, uint64_t msc, double time)
+{
+    if (window->callbacks.present)
+        window->callbacks.present((GLFWwindow*) window, count, msc, time);
+}
+
 void _glfwInputWindowCloseRequest(_GLFWwindow* window)
 {
     if (window->callbacks.close)
@@ -177,6 +184,7 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     wndconfig.title         = title;
     wndconfig.resizable     = _glfw.hints.resizable ? GL_TRUE : GL_FALSE;
     wndconfig.visible       = _glfw.hints.visible ? GL_TRUE : GL_FALSE;
+    wndconfig.headless      = _glfw.hints.headless ? GL_TRUE : GL_FALSE;
     wndconfig.clientAPI     = _glfw.hints.clientAPI;
     wndconfig.glMajor       = _glfw.hints.glMajor;
     wndconfig.glMinor       = _glfw.hints.glMinor;
@@ -187,6 +195,20 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     wndconfig.monitor       = (_GLFWmonitor*) monitor;
     wndconfig.share         = (_GLFWwindow*) share;
 
+    if (wndconfig.headless)
+    {
+        if (wndconfig.monitor)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Headless windows cannot be fullscreen");
+            return NULL;
+        }
+
+        // There is nothing to show or resize
+        wndconfig.resizable = GL_FALSE;
+        wndconfig.visible   = GL_FALSE;
+    }
+
     // Check the OpenGL bits of the window config
     if (!_glfwIsValidContextConfig(&wndconfig))
         return GL_FALSE;
@@ -215,8 +237,15 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
 
     window->monitor    = wndconfig.monitor;
     window->resizable  = wndconfig.resizable;
+    window->headless   = wndconfig.headless;
     window->cursorMode = GLFW_CURSOR_NORMAL;
 
+    if (wndconfig.headless)
+    {
+        window->headlessWidth  = width;
+        window->headlessHeight = height;
+    }
+
     // Save the currently current context so it can be restored later
     previous = (_GLFWwindow*) glfwGetCurrentContext();
 
@@ -336,6 +365,9 @@ GLFWAPI void glfwWindowHint(int target, int hint)
         case GLFW_VISIBLE:
             _glfw.hints.visible = hint;
             break;
+        case GLFW_HEADLESS:
+            _glfw.hints.headless = hint;
+            break;
         case GLFW_SAMPLES:
             _glfw.hints.samples = hint;
             break;
@@ -403,20 +435,40 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
         *prev = window->next;
     }
 
+    _glfwFreeExtensionSet(&window->extensions);
+    _glfwFreeExtensionSet(&window->procs);
+    free(window->queue.events);
     free(window);
 }
 
 GLFWAPI void glfwSetWindowTitle(GLFWwindow* handle, const char* title)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
+
     _GLFW_REQUIRE_INIT();
+
+    if (window->headless)
+        return;
+
     _glfwPlatformSetWindowTitle(window, title);
 }
 
 GLFWAPI void glfwGetWindowPos(GLFWwindow* handle, int* xpos, int* ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
+
     _GLFW_REQUIRE_INIT();
+
+    if (window->headless)
+    {
+        if (xpos)
+            *xpos = 0;
+        if (ypos)
+            *ypos = 0;
+
+        return;
+    }
+
     _glfwPlatformGetWindowPos(window, xpos, ypos);
 }
 
@@ -433,13 +485,28 @@ GLFWAPI void glfwSetWindowPos(GLFWwindow* handle, int xpos, int ypos)
         return;
     }
 
+    if (window->headless)
+        return;
+
     _glfwPlatformSetWindowPos(window, xpos, ypos);
 }
 
 GLFWAPI void glfwGetWindowSize(GLFWwindow* handle, int* width, int* height)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
+
     _GLFW_REQUIRE_INIT();
+
+    if (window->headless)
+    {
+        if (width)
+            *width = window->headlessWidth;
+        if (height)
+            *height = window->headlessHeight;
+
+        return;
+    }
+
     _glfwPlatformGetWindowSize(window, width, height);
 }
 
@@ -449,7 +516,7 @@ GLFWAPI void glfwSetWindowSize(GLFWwindow* handle, int width, int height)
 
     _GLFW_REQUIRE_INIT();
 
-    if (window->iconified)
+    if (window->iconified || window->headless)
     {
         // TODO: Figure out if this is an error
         return;
@@ -469,7 +536,7 @@ GLFWAPI void glfwSetWindowIcons(GLFWwindow* handle, GLFWimage* icons, int numico
     _GLFWwindow* window = (_GLFWwindow*) handle;
     _GLFW_REQUIRE_INIT();
 
-    if (numicons < 1)
+    if (numicons < 1 || window->headless)
     {
         return;
     }
@@ -483,7 +550,7 @@ GLFWAPI void glfwIconifyWindow(GLFWwindow* handle)
 
     _GLFW_REQUIRE_INIT();
 
-    if (window->iconified)
+    if (window->iconified || window->headless)
         return;
 
     _glfwPlatformIconifyWindow(window);
@@ -507,7 +574,7 @@ GLFWAPI void glfwShowWindow(GLFWwindow* handle)
 
     _GLFW_REQUIRE_INIT();
 
-    if (window->monitor)
+    if (window->monitor || window->headless)
         return;
 
     _glfwPlatformShowWindow(window);
@@ -519,7 +586,7 @@ GLFWAPI void glfwHideWindow(GLFWwindow* handle)
 
     _GLFW_REQUIRE_INIT();
 
-    if (window->monitor)
+    if (window->monitor || window->headless)
         return;
 
     _glfwPlatformHideWindow(window);
@@ -543,6 +610,8 @@ GLFWAPI int glfwGetWindowParam(GLFWwindow* handle, int param)
             return window->resizable;
         case GLFW_VISIBLE:
             return window->visible;
+        case GLFW_HEADLESS:
+            return window->headless;
         case GLFW_CLIENT_API:
             return window->clientAPI;
         case GLFW_CONTEXT_VERSION_MAJOR:
@@ -614,6 +683,13 @@ GLFWAPI void glfwSetWindowRefreshCallback(GLFWwindow* handle, GLFWwindowrefreshf
     window->callbacks.refresh = cbfun;
 }
 
+GLFWAPI void glfwSetWindowPresentCallback(GLFWwindow* handle, GLFWwindowpresentfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFW_REQUIRE_INIT();
+    window->callbacks.present = cbfun;
+}
+
 GLFWAPI void glfwSetWindowFocusCallback(GLFWwindow* handle, GLFWwindowfocusfun cbfun)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -640,3 +716,22 @@ GLFWAPI void glfwWaitEvents(void)
     _glfwPlatformWaitEvents();
 }
 
+GLFWAPI void glfwWaitEventsTimeout(double timeout)
+{
+    _GLFW_REQUIRE_INIT();
+
+    if (timeout < 0.0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid timeout");
+        return;
+    }
+
+    _glfwPlatformWaitEventsTimeout(timeout);
+}
+
+GLFWAPI void glfwPostEmptyEvent(void)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfwPlatformPostEmptyEvent();
+}
+
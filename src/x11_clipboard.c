@@ -33,15 +33,467 @@
 #include <limits.h>
 #include <string.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
 
 
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW internal API                      //////
-//////////////////////////////////////////////////////////////////////////
+// Returns whether the event is a selection notification for the window
+//
+static Bool isSelectionNotify(Display* display, XEvent* event, XPointer pointer)
+{
+    _GLFWwindow* window = (_GLFWwindow*) pointer;
+
+    return event->type == SelectionNotify &&
+           event->xselection.requestor == window->x11.handle;
+}
+
+// Returns whether the event announces the next chunk of an incremental
+// transfer to the window
+//
+static Bool isSelectionChunk(Display* display, XEvent* event, XPointer pointer)
+{
+    _GLFWwindow* window = (_GLFWwindow*) pointer;
+
+    return event->type == PropertyNotify &&
+           event->xproperty.window == window->x11.handle &&
+           event->xproperty.atom == _glfw.x11.selection.property &&
+           event->xproperty.state == PropertyNewValue;
+}
+
+// Returns the timer value at which a request started now times out, or zero
+// if it never does
+// The raw timer is used, as glfwSetTime may move the GLFW time at any point
+//
+static uint64_t getRequestDeadline(void)
+{
+    if (_glfw.clipboardTimeout <= 0.0)
+        return 0;
+
+    return _glfwPlatformGetTimerValue() +
+           (uint64_t) (_glfw.clipboardTimeout *
+                       (double) _glfwPlatformGetTimerFrequency());
+}
+
+// Waits for an event matching the predicate without spinning
+// Returns GL_FALSE if the deadline passed first, where a zero deadline means
+// no limit
+//
+static GLboolean waitForMatchingEvent(_GLFWwindow* window,
+                                      XEvent* event,
+                                      Bool (*predicate)(Display*, XEvent*, XPointer),
+                                      uint64_t deadline)
+{
+    struct pollfd fd;
+
+    fd.fd = ConnectionNumber(_glfw.x11.display);
+    fd.events = POLLIN;
+
+    // XCheckIfEvent flushes the output buffer and reads any pending events
+    // before giving up, so only new data on the connection needs waiting for
+    while (!XCheckIfEvent(_glfw.x11.display, event,
+                          predicate, (XPointer) window))
+    {
+        int timeout = -1;
+
+        if (deadline)
+        {
+            const uint64_t now = _glfwPlatformGetTimerValue();
+            double remaining;
+
+            if (now >= deadline)
+                return GL_FALSE;
+
+            remaining = (double) (deadline - now) /
+                        (double) _glfwPlatformGetTimerFrequency();
+            if (remaining < INT_MAX / 1000)
+                timeout = (int) (remaining * 1000.0) + 1;
+        }
+
+        if (poll(&fd, 1, timeout) == -1 && errno != EINTR)
+            return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
+
+// Reads and deletes the selection property of the window
+// Returns the type of the property, or None if it could not be read
+//
+static Atom readSelectionProperty(Window handle,
+                                  unsigned char** data,
+                                  unsigned long* size)
+{
+    Atom actualType;
+    int actualFormat;
+    unsigned long bytesAfter;
+
+    *data = NULL;
+    *size = 0;
+
+    XGetWindowProperty(_glfw.x11.display,
+                       handle,
+                       _glfw.x11.selection.property,
+                       0, LONG_MAX,
+                       False,
+                       AnyPropertyType,
+                       &actualType,
+                       &actualFormat,
+                       size,
+                       &bytesAfter,
+                       data);
+
+    XDeleteProperty(_glfw.x11.display, handle, _glfw.x11.selection.property);
+
+    if (actualType == None)
+    {
+        XFree(*data);
+        *data = NULL;
+        *size = 0;
+    }
+
+    return actualType;
+}
+
+// Appends data to a heap-allocated, NUL-terminated buffer
+//
+static GLboolean appendData(char** buffer, size_t* length,
+                            const unsigned char* data, size_t size)
+{
+    char* result = realloc(*buffer, *length + size + 1);
+    if (!result)
+        return GL_FALSE;
+
+    memcpy(result + *length, data, size);
+    *length += size;
+    result[*length] = '\0';
+
+    *buffer = result;
+    return GL_TRUE;
+}
+
+// Receives the remaining chunks of an incremental transfer to the window
+// Returns a copy of the contents, or NULL if the transfer failed
+//
+static char* receiveIncremental(_GLFWwindow* window, Atom target,
+                                uint64_t deadline)
+{
+    char* string = NULL;
+    size_t length = 0;
+
+    for (;;)
+    {
+        XEvent event;
+        unsigned char* data;
+        unsigned long size;
+        Atom type;
+
+        if (!waitForMatchingEvent(window, &event, isSelectionChunk, deadline))
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "X11: Timed out waiting for the clipboard owner");
+            free(string);
+            return NULL;
+        }
+
+        type = readSelectionProperty(window->x11.handle, &data, &size);
+        if (type == None)
+        {
+            // This notification predates the chunk, which is still to come
+            continue;
+        }
+
+        if (type != target)
+        {
+            XFree(data);
+            free(string);
+            return NULL;
+        }
+
+        if (size == 0)
+        {
+            // A zero-length chunk marks the end of the transfer
+            XFree(data);
+
+            if (!string)
+                string = strdup("");
+
+            return string;
+        }
+
+        if (!appendData(&string, &length, data, size))
+        {
+            XFree(data);
+            free(string);
+            return NULL;
+        }
+
+        XFree(data);
+    }
+}
+
+// The error code caught by the foreign window error trap, if any
+//
+static unsigned char foreignErrorCode = Success;
+
+// The error handler installed before the foreign window error trap
+//
+static XErrorHandler previousErrorHandler = NULL;
+
+// Error handler used for requests on windows of other clients
+//
+static int foreignErrorHandler(Display* display, XErrorEvent* event)
+{
+    // Other clients may destroy their windows at any time, but any other
+    // error is still a bug
+    if (event->error_code != BadWindow)
+        return previousErrorHandler(display, event);
+
+    foreignErrorCode = event->error_code;
+    return 0;
+}
+
+// Starts catching errors caused by requests on windows of other clients
+//
+static void beginForeignRequests(void)
+{
+    foreignErrorCode = Success;
+    previousErrorHandler = XSetErrorHandler(foreignErrorHandler);
+}
+
+// Stops catching errors caused by requests on windows of other clients
+// Returns GL_FALSE if any of the windows no longer existed
+//
+static GLboolean endForeignRequests(void)
+{
+    XSync(_glfw.x11.display, False);
+    XSetErrorHandler(previousErrorHandler);
+    return foreignErrorCode == Success;
+}
+
+// Selects the events still needed from the specified window of another client
+// It may both be receiving our selection and owning the one we requested
+// This must be called between beginForeignRequests and endForeignRequests
+//
+static void updateForeignEventMask(Window handle)
+{
+    int i;
+    long mask = NoEventMask;
+    _GLFWwindow* window;
+
+    for (i = 0;  i < _GLFW_SELECTION_TRANSFER_COUNT;  i++)
+    {
+        // The requestor deletes the property to ask for each chunk (ICCCM
+        // section 2.7.2), and may go away in the middle of the transfer
+        if (_glfw.x11.selection.transfers[i].requestor == handle)
+            mask |= PropertyChangeMask | StructureNotifyMask;
+    }
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        // The owner may go away before our request has been answered
+        if ((window->x11.clipboard.callback || window->x11.clipboard.stream) &&
+            window->x11.clipboard.owner == handle)
+        {
+            mask |= StructureNotifyMask;
+        }
+    }
+
+    XSelectInput(_glfw.x11.display, handle, mask);
+}
+
+// Stops sending the specified incremental transfer
+//
+static void endTransfer(int index)
+{
+    const Window requestor = _glfw.x11.selection.transfers[index].requestor;
+
+    memset(_glfw.x11.selection.transfers + index, 0, sizeof(_GLFWtransferX11));
+
+    // The requestor may already be gone, with its DestroyNotify still queued
+    beginForeignRequests();
+    updateForeignEventMask(requestor);
+    endForeignRequests();
+}
+
+// Starts sending the clipboard string to the requestor in chunks
+// Returns GL_FALSE if no more transfers can be handled at this time
+// This must be called between beginForeignRequests and endForeignRequests
+//
+static GLboolean beginTransfer(XSelectionRequestEvent* request, size_t length)
+{
+    int i;
+    // Xlib expects format 32 property data as an array of long
+    long size = (long) length;
+
+    for (i = 0;  i < _GLFW_SELECTION_TRANSFER_COUNT;  i++)
+    {
+        if (!_glfw.x11.selection.transfers[i].requestor)
+            break;
+    }
+
+    if (i == _GLFW_SELECTION_TRANSFER_COUNT)
+        return GL_FALSE;
+
+    _glfw.x11.selection.transfers[i].requestor = request->requestor;
+    _glfw.x11.selection.transfers[i].property = request->property;
+    _glfw.x11.selection.transfers[i].target = request->target;
+    _glfw.x11.selection.transfers[i].offset = 0;
+    _glfw.x11.selection.transfers[i].length = length;
+
+    updateForeignEventMask(request->requestor);
+
+    XChangeProperty(_glfw.x11.display,
+                    request->requestor,
+                    request->property,
+                    _glfw.x11.INCR,
+                    32,
+                    PropModeReplace,
+                    (unsigned char*) &size,
+                    1);
+
+    return GL_TRUE;
+}
+
+// Starts or continues delivering selection data to the pending request
+//
+static void deliverChunk(_GLFWwindow* window,
+                         const unsigned char* data,
+                         unsigned long size)
+{
+    if (window->x11.clipboard.stream)
+    {
+        window->x11.clipboard.stream((GLFWwindow*) window,
+                                     (const char*) data, (int) size);
+    }
+    else
+    {
+        appendData(&window->x11.clipboard.data,
+                   &window->x11.clipboard.length,
+                   data, size);
+    }
+}
+
+// Completes the pending asynchronous clipboard request without reporting any
+// error
+//
+static void finishRequest(_GLFWwindow* window, GLboolean success)
+{
+    GLFWclipboardfun callback = window->x11.clipboard.callback;
+    GLFWclipboardstreamfun stream = window->x11.clipboard.stream;
+    char* string = window->x11.clipboard.data;
+
+    // The request is complete before the callback runs, so that the callback
+    // may issue a new request
+    // The owner keeps its event mask, as it may already have been destroyed
+    memset(&window->x11.clipboard, 0, sizeof(window->x11.clipboard));
+
+    if (stream)
+        stream((GLFWwindow*) window, success ? "" : NULL, 0);
+    else
+        callback((GLFWwindow*) window, success ? string : NULL);
+
+    free(string);
+}
+
+// Completes the pending asynchronous clipboard request
+//
+static void endRequest(_GLFWwindow* window, GLboolean success)
+{
+    if (success && !window->x11.clipboard.stream && !window->x11.clipboard.data)
+        success = GL_FALSE;
+
+    if (!success)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Failed to convert selection to string");
+    }
+
+    finishRequest(window, success);
+}
+
+// Fails the pending asynchronous clipboard request with the specified error
+//
+static void failRequest(_GLFWwindow* window, const char* description)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR, description);
+    finishRequest(window, GL_FALSE);
+}
+
+// Starts an asynchronous clipboard request
+//
+static void beginRequest(_GLFWwindow* window,
+                         GLFWclipboardfun callback,
+                         GLFWclipboardstreamfun stream)
+{
+    const Window owner = XGetSelectionOwner(_glfw.x11.display,
+                                            _glfw.x11.CLIPBOARD);
+
+    if (_glfwFindWindowByHandle(owner))
+    {
+        // We own the selection, so there is no need to ask for it
+        const char* string = _glfw.x11.selection.string;
+
+        if (stream)
+        {
+            stream((GLFWwindow*) window, string, (int) strlen(string));
+            stream((GLFWwindow*) window, "", 0);
+        }
+        else
+            callback((GLFWwindow*) window, string);
+
+        return;
+    }
+
+    if (window->x11.clipboard.callback || window->x11.clipboard.stream)
+    {
+        if (!window->x11.clipboard.stream != !stream)
+        {
+            // Chunks already received could not be delivered consistently
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "X11: A clipboard request of another kind is "
+                            "already pending for the window");
+            return;
+        }
+
+        // A conversion is already in flight; its reply goes to the new callback
+        window->x11.clipboard.callback = callback;
+        window->x11.clipboard.stream = stream;
+        return;
+    }
+
+    window->x11.clipboard.callback = callback;
+    window->x11.clipboard.stream = stream;
+    window->x11.clipboard.format = 0;
+    window->x11.clipboard.owner = owner;
+
+    window->x11.clipboard.deadline = getRequestDeadline();
+
+    if (owner)
+    {
+        // The owner may be destroyed before the selection reaches the server
+        beginForeignRequests();
+        updateForeignEventMask(owner);
+
+        if (!endForeignRequests())
+        {
+            failRequest(window, "X11: The clipboard owner went away");
+            return;
+        }
+    }
+
+    XConvertSelection(_glfw.x11.display,
+                      _glfw.x11.CLIPBOARD,
+                      _glfw.x11.selection.formats[0],
+                      _glfw.x11.selection.property,
+                      window->x11.handle, CurrentTime);
+    XFlush(_glfw.x11.display);
+}
+
 
 // Set the specified property to the contents of the requested selection
+// This must be called between beginForeignRequests and endForeignRequests
 //
-Atom _glfwWriteSelection(XSelectionRequestEvent* request)
+static Atom writeSelection(XSelectionRequestEvent* request)
 {
     int i;
 
@@ -73,6 +525,17 @@ Atom _glfwWriteSelection(XSelectionRequestEvent* request)
         {
             // The requested target is one we support
 
+            const size_t length = strlen(_glfw.x11.selection.string);
+
+            if (length > _glfw.x11.selection.chunkSize)
+            {
+                // The string is too large to send in a single request
+                if (!beginTransfer(request, length))
+                    return None;
+
+                return request->property;
+            }
+
             XChangeProperty(_glfw.x11.display,
                             request->requestor,
                             request->property,
@@ -80,7 +543,7 @@ Atom _glfwWriteSelection(XSelectionRequestEvent* request)
                             8,
                             PropModeReplace,
                             (unsigned char*) _glfw.x11.selection.string,
-                            strlen(_glfw.x11.selection.string));
+                            length);
 
             return request->property;
         }
@@ -90,12 +553,306 @@ Atom _glfwWriteSelection(XSelectionRequestEvent* request)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Write the requested selection for the requestor and notify it
+//
+void _glfwHandleSelectionRequest(XSelectionRequestEvent* request)
+{
+    int i;
+    XEvent response;
+    memset(&response, 0, sizeof(response));
+
+    // The requestor may go away before the reply reaches it
+    beginForeignRequests();
+
+    response.xselection.property = writeSelection(request);
+    response.xselection.type = SelectionNotify;
+    response.xselection.display = request->display;
+    response.xselection.requestor = request->requestor;
+    response.xselection.selection = request->selection;
+    response.xselection.target = request->target;
+    response.xselection.time = request->time;
+
+    XSendEvent(_glfw.x11.display,
+               request->requestor,
+               False, 0, &response);
+
+    if (endForeignRequests())
+        return;
+
+    for (i = 0;  i < _GLFW_SELECTION_TRANSFER_COUNT;  i++)
+    {
+        // The requestor is gone, so no DestroyNotify may arrive for it
+        if (_glfw.x11.selection.transfers[i].requestor == request->requestor)
+        {
+            memset(_glfw.x11.selection.transfers + i, 0,
+                   sizeof(_GLFWtransferX11));
+        }
+    }
+}
+
+// Send the next chunk of any incremental transfer the event asks for
+// Returns GL_TRUE if the event belonged to an incremental transfer
+//
+GLboolean _glfwHandleSelectionTransfer(XEvent* event)
+{
+    int i;
+
+    if (event->type != PropertyNotify && event->type != DestroyNotify)
+        return GL_FALSE;
+
+    if (event->type == DestroyNotify)
+    {
+        _GLFWwindow* window = _glfw.windowListHead;
+
+        while (window)
+        {
+            if ((window->x11.clipboard.callback || window->x11.clipboard.stream) &&
+                window->x11.clipboard.owner == event->xdestroywindow.window)
+            {
+                // The owner went away before our request was answered
+                // The callback may destroy windows, so the search restarts
+                failRequest(window, "X11: The clipboard owner went away");
+                window = _glfw.windowListHead;
+            }
+            else
+                window = window->next;
+        }
+    }
+
+    for (i = 0;  i < _GLFW_SELECTION_TRANSFER_COUNT;  i++)
+    {
+        size_t size;
+        const char* string = _glfw.x11.selection.string;
+        _GLFWtransferX11* transfer = _glfw.x11.selection.transfers + i;
+
+        if (transfer->requestor != event->xany.window)
+            continue;
+
+        if (event->type == DestroyNotify)
+        {
+            // The requestor went away before the transfer was complete
+            memset(transfer, 0, sizeof(_GLFWtransferX11));
+            continue;
+        }
+
+        if (event->xproperty.atom != transfer->property)
+            continue;
+
+        if (event->xproperty.state != PropertyDelete)
+            return GL_TRUE;
+
+        size = transfer->length - transfer->offset;
+        if (size > _glfw.x11.selection.chunkSize)
+            size = _glfw.x11.selection.chunkSize;
+
+        // The requestor may exit right after asking for the next chunk
+        beginForeignRequests();
+
+        // The final, zero-length chunk marks the end of the transfer
+        XChangeProperty(_glfw.x11.display,
+                        transfer->requestor,
+                        transfer->property,
+                        transfer->target,
+                        8,
+                        PropModeReplace,
+                        (unsigned char*) string + transfer->offset,
+                        size);
+
+        if (!endForeignRequests())
+        {
+            // The requestor went away in the middle of the transfer
+            memset(transfer, 0, sizeof(_GLFWtransferX11));
+            return GL_TRUE;
+        }
+
+        if (size == 0)
+            endTransfer(i);
+        else
+            transfer->offset += size;
+
+        return GL_TRUE;
+    }
+
+    return GL_FALSE;
+}
+
+// Continue or complete the pending asynchronous clipboard request, if any
+//
+void _glfwHandleSelectionNotify(_GLFWwindow* window, XSelectionEvent* event)
+{
+    unsigned char* data;
+    unsigned long size;
+    Atom type;
+
+    if (!window->x11.clipboard.callback && !window->x11.clipboard.stream)
+    {
+        // This is a late reply to a timed out synchronous request
+        if (event->property != None)
+            XDeleteProperty(_glfw.x11.display, event->requestor, event->property);
+
+        return;
+    }
+
+    if (event->property == None)
+        type = None;
+    else
+        type = readSelectionProperty(window->x11.handle, &data, &size);
+
+    if (type == _glfw.x11.INCR)
+    {
+        // The property was deleted above, which asks for the first chunk
+        window->x11.clipboard.incremental = GL_TRUE;
+        XFree(data);
+        return;
+    }
+
+    if (type != None && type == event->target)
+    {
+        if (window->x11.clipboard.stream)
+        {
+            deliverChunk(window, data, size);
+            XFree(data);
+            endRequest(window, GL_TRUE);
+        }
+        else
+        {
+            // Xlib terminates property data, so it can be handed over as is
+            GLFWclipboardfun callback = window->x11.clipboard.callback;
+            memset(&window->x11.clipboard, 0, sizeof(window->x11.clipboard));
+            callback((GLFWwindow*) window, (const char*) data);
+            XFree(data);
+        }
+
+        return;
+    }
+
+    if (type != None)
+        XFree(data);
+
+    if (++window->x11.clipboard.format < _GLFW_CLIPBOARD_FORMAT_COUNT)
+    {
+        // Try the next format in order of preference
+        XConvertSelection(_glfw.x11.display,
+                          _glfw.x11.CLIPBOARD,
+                          _glfw.x11.selection.formats[window->x11.clipboard.format],
+                          _glfw.x11.selection.property,
+                          window->x11.handle, CurrentTime);
+        return;
+    }
+
+    endRequest(window, GL_FALSE);
+}
+
+// Receive the next chunk of the incremental transfer to the window, if any
+//
+void _glfwHandleSelectionChunk(_GLFWwindow* window, XPropertyEvent* event)
+{
+    unsigned char* data;
+    unsigned long size;
+    Atom type;
+
+    if (!window->x11.clipboard.incremental ||
+        event->atom != _glfw.x11.selection.property ||
+        event->state != PropertyNewValue)
+    {
+        return;
+    }
+
+    type = readSelectionProperty(window->x11.handle, &data, &size);
+    if (type == None)
+    {
+        // This notification predates the chunk, which is still to come
+        return;
+    }
+
+    if (type != _glfw.x11.selection.formats[window->x11.clipboard.format])
+    {
+        XFree(data);
+        endRequest(window, GL_FALSE);
+        return;
+    }
+
+    if (size == 0)
+    {
+        // A zero-length chunk marks the end of the transfer
+        XFree(data);
+
+        if (!window->x11.clipboard.stream && !window->x11.clipboard.data)
+            window->x11.clipboard.data = strdup("");
+
+        endRequest(window, GL_TRUE);
+        return;
+    }
+
+    deliverChunk(window, data, size);
+    XFree(data);
+}
+
+
+// Fails the asynchronous clipboard requests that have timed out
+//
+void _glfwCheckClipboardRequests(void)
+{
+    const uint64_t now = _glfwPlatformGetTimerValue();
+    _GLFWwindow* window = _glfw.windowListHead;
+
+    while (window)
+    {
+        if ((window->x11.clipboard.callback || window->x11.clipboard.stream) &&
+            window->x11.clipboard.deadline &&
+            window->x11.clipboard.deadline <= now)
+        {
+            // The callback may destroy windows, so the search restarts
+            failRequest(window, "X11: Timed out waiting for the clipboard owner");
+            window = _glfw.windowListHead;
+        }
+        else
+            window = window->next;
+    }
+}
+
+// Returns the earliest timer value at which an asynchronous clipboard request
+// times out, or zero if none of them can
+//
+uint64_t _glfwGetClipboardDeadline(void)
+{
+    uint64_t deadline = 0;
+    _GLFWwindow* window;
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        const uint64_t current = window->x11.clipboard.deadline;
+
+        if (!window->x11.clipboard.callback && !window->x11.clipboard.stream)
+            continue;
+
+        if (current && (!deadline || current < deadline))
+            deadline = current;
+    }
+
+    return deadline;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
 
 void _glfwPlatformSetClipboardString(_GLFWwindow* window, const char* string)
 {
+    int i;
+
+    // Transfers in progress refer to the old string
+    for (i = 0;  i < _GLFW_SELECTION_TRANSFER_COUNT;  i++)
+    {
+        if (_glfw.x11.selection.transfers[i].requestor)
+            endTransfer(i);
+    }
+
     free(_glfw.x11.selection.string);
     _glfw.x11.selection.string = strdup(string);
 
@@ -114,6 +871,7 @@ void _glfwPlatformSetClipboardString(_GLFWwindow* window, const char* string)
 const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
 {
     int i;
+    uint64_t deadline;
 
     if (_glfwFindWindowByHandle(XGetSelectionOwner(_glfw.x11.display,
                                                    _glfw.x11.CLIPBOARD)))
@@ -123,51 +881,60 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
         return _glfw.x11.selection.string;
     }
 
+    if (window->x11.clipboard.callback || window->x11.clipboard.stream)
+    {
+        // The reply to the pending request could not be told apart from ours
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: A clipboard request is already pending for the "
+                        "window");
+        return NULL;
+    }
+
     free(_glfw.x11.selection.string);
     _glfw.x11.selection.string = NULL;
 
+    deadline = getRequestDeadline();
+
     for (i = 0;  i < _GLFW_CLIPBOARD_FORMAT_COUNT;  i++)
     {
-        Atom actualType;
-        int actualFormat;
-        unsigned long itemCount, bytesAfter;
-        char* data;
         XEvent event;
+        unsigned char* data;
+        unsigned long size;
+        Atom type;
+        const Atom target = _glfw.x11.selection.formats[i];
 
         XConvertSelection(_glfw.x11.display,
                           _glfw.x11.CLIPBOARD,
-                          _glfw.x11.selection.formats[i],
+                          target,
                           _glfw.x11.selection.property,
                           window->x11.handle, CurrentTime);
 
-        // XCheckTypedEvent is used instead of XIfEvent in order not to lock
-        // other threads out from the display during the entire wait period
-        while (!XCheckTypedEvent(_glfw.x11.display, SelectionNotify, &event))
-            ;
+        if (!waitForMatchingEvent(window, &event, isSelectionNotify, deadline))
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "X11: Timed out waiting for the clipboard owner");
+            return NULL;
+        }
 
         if (event.xselection.property == None)
             continue;
 
-        XGetWindowProperty(_glfw.x11.display,
-                           event.xselection.requestor,
-                           event.xselection.property,
-                           0, LONG_MAX,
-                           False,
-                           event.xselection.target,
-                           &actualType,
-                           &actualFormat,
-                           &itemCount,
-                           &bytesAfter,
-                           (unsigned char**) &data);
-
-        XDeleteProperty(_glfw.x11.display,
-                        event.xselection.requestor,
-                        event.xselection.property);
-
-        if (actualType == event.xselection.target)
-            _glfw.x11.selection.string = strdup(data);
+        type = readSelectionProperty(window->x11.handle, &data, &size);
+        if (type == _glfw.x11.INCR)
+        {
+            // The property was deleted above, which asks for the first chunk
+            XFree(data);
+            _glfw.x11.selection.string =
+                receiveIncremental(window, target, deadline);
+        }
+        else
+        {
+            if (type == target)
+                _glfw.x11.selection.string = strdup((char*) data);
 
-        XFree(data);
+            if (type != None)
+                XFree(data);
+        }
 
         if (_glfw.x11.selection.string)
             break;
@@ -182,3 +949,15 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
     return _glfw.x11.selection.string;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window,
+                                         GLFWclipboardfun cbfun)
+{
+    beginRequest(window, cbfun, NULL);
+}
+
+void _glfwPlatformRequestClipboardStream(_GLFWwindow* window,
+                                         GLFWclipboardstreamfun cbfun)
+{
+    beginRequest(window, NULL, cbfun);
+}
+
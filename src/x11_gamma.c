@@ -51,8 +51,10 @@ void _glfwInitGammaRamp(void)
         // This is reasonable as I suspect the that if they did differ, it
         // would imply that setting the gamma size to an arbitary size is
         // possible as well.
-        XRRScreenResources* rr = XRRGetScreenResources(_glfw.x11.display,
-                                                       _glfw.x11.root);
+        // The current resources are enough here and, unlike a full query,
+        // do not make the server probe the outputs
+        XRRScreenResources* rr = XRRGetScreenResourcesCurrent(_glfw.x11.display,
+                                                              _glfw.x11.root);
 
         if (XRRGetCrtcGammaSize(_glfw.x11.display, rr->crtcs[0]))
         {
@@ -63,6 +65,16 @@ void _glfwInitGammaRamp(void)
 
         XRRFreeScreenResources(rr);
     }
+
+    if (!_glfw.x11.randr.available || _glfw.x11.randr.gammaBroken)
+    {
+        // Xf86VidMode is only used as a gamma fallback, so only pay for the
+        // query when RandR cannot be used
+        _glfw.x11.vidmode.available =
+            XF86VidModeQueryExtension(_glfw.x11.display,
+                                      &_glfw.x11.vidmode.eventBase,
+                                      &_glfw.x11.vidmode.errorBase);
+    }
 }
 
 
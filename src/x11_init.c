@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <fcntl.h>
 
 
 // Translate an X11 key code to a GLFW key code.
@@ -212,122 +213,188 @@ static int keyCodeToGLFWKeyCode(int keyCode)
     return -1;
 }
 
-// Update the key code LUT
+// Pack a four character XKB key name into an integer
 //
-static void updateKeyCodeLUT(void)
+#define KEY_NAME(a, b, c, d) \
+    ((unsigned int) (a) | ((unsigned int) (b) << 8) | \
+     ((unsigned int) (c) << 16) | ((unsigned int) (d) << 24))
+
+// Translate a packed XKB key name to a GLFW key code
+//
+static int keyNameToGLFWKeyCode(unsigned int name)
 {
-    int i, keyCode, keyCodeGLFW;
-    char name[XkbKeyNameLength + 1];
-    XkbDescPtr descr;
+    // Note: We only map printable keys here, and we use the US keyboard
+    // layout.  The rest of the keys (function keys) are mapped using
+    // traditional KeySym translations.
+    switch (name)
+    {
+        case KEY_NAME('T', 'L', 'D', 'E'): return GLFW_KEY_GRAVE_ACCENT;
+        case KEY_NAME('A', 'E', '0', '1'): return GLFW_KEY_1;
+        case KEY_NAME('A', 'E', '0', '2'): return GLFW_KEY_2;
+        case KEY_NAME('A', 'E', '0', '3'): return GLFW_KEY_3;
+        case KEY_NAME('A', 'E', '0', '4'): return GLFW_KEY_4;
+        case KEY_NAME('A', 'E', '0', '5'): return GLFW_KEY_5;
+        case KEY_NAME('A', 'E', '0', '6'): return GLFW_KEY_6;
+        case KEY_NAME('A', 'E', '0', '7'): return GLFW_KEY_7;
+        case KEY_NAME('A', 'E', '0', '8'): return GLFW_KEY_8;
+        case KEY_NAME('A', 'E', '0', '9'): return GLFW_KEY_9;
+        case KEY_NAME('A', 'E', '1', '0'): return GLFW_KEY_0;
+        case KEY_NAME('A', 'E', '1', '1'): return GLFW_KEY_MINUS;
+        case KEY_NAME('A', 'E', '1', '2'): return GLFW_KEY_EQUAL;
+        case KEY_NAME('A', 'D', '0', '1'): return GLFW_KEY_Q;
+        case KEY_NAME('A', 'D', '0', '2'): return GLFW_KEY_W;
+        case KEY_NAME('A', 'D', '0', '3'): return GLFW_KEY_E;
+        case KEY_NAME('A', 'D', '0', '4'): return GLFW_KEY_R;
+        case KEY_NAME('A', 'D', '0', '5'): return GLFW_KEY_T;
+        case KEY_NAME('A', 'D', '0', '6'): return GLFW_KEY_Y;
+        case KEY_NAME('A', 'D', '0', '7'): return GLFW_KEY_U;
+        case KEY_NAME('A', 'D', '0', '8'): return GLFW_KEY_I;
+        case KEY_NAME('A', 'D', '0', '9'): return GLFW_KEY_O;
+        case KEY_NAME('A', 'D', '1', '0'): return GLFW_KEY_P;
+        case KEY_NAME('A', 'D', '1', '1'): return GLFW_KEY_LEFT_BRACKET;
+        case KEY_NAME('A', 'D', '1', '2'): return GLFW_KEY_RIGHT_BRACKET;
+        case KEY_NAME('A', 'C', '0', '1'): return GLFW_KEY_A;
+        case KEY_NAME('A', 'C', '0', '2'): return GLFW_KEY_S;
+        case KEY_NAME('A', 'C', '0', '3'): return GLFW_KEY_D;
+        case KEY_NAME('A', 'C', '0', '4'): return GLFW_KEY_F;
+        case KEY_NAME('A', 'C', '0', '5'): return GLFW_KEY_G;
+        case KEY_NAME('A', 'C', '0', '6'): return GLFW_KEY_H;
+        case KEY_NAME('A', 'C', '0', '7'): return GLFW_KEY_J;
+        case KEY_NAME('A', 'C', '0', '8'): return GLFW_KEY_K;
+        case KEY_NAME('A', 'C', '0', '9'): return GLFW_KEY_L;
+        case KEY_NAME('A', 'C', '1', '0'): return GLFW_KEY_SEMICOLON;
+        case KEY_NAME('A', 'C', '1', '1'): return GLFW_KEY_APOSTROPHE;
+        case KEY_NAME('A', 'B', '0', '1'): return GLFW_KEY_Z;
+        case KEY_NAME('A', 'B', '0', '2'): return GLFW_KEY_X;
+        case KEY_NAME('A', 'B', '0', '3'): return GLFW_KEY_C;
+        case KEY_NAME('A', 'B', '0', '4'): return GLFW_KEY_V;
+        case KEY_NAME('A', 'B', '0', '5'): return GLFW_KEY_B;
+        case KEY_NAME('A', 'B', '0', '6'): return GLFW_KEY_N;
+        case KEY_NAME('A', 'B', '0', '7'): return GLFW_KEY_M;
+        case KEY_NAME('A', 'B', '0', '8'): return GLFW_KEY_COMMA;
+        case KEY_NAME('A', 'B', '0', '9'): return GLFW_KEY_PERIOD;
+        case KEY_NAME('A', 'B', '1', '0'): return GLFW_KEY_SLASH;
+        case KEY_NAME('B', 'K', 'S', 'L'): return GLFW_KEY_BACKSLASH;
+        case KEY_NAME('L', 'S', 'G', 'T'): return GLFW_KEY_WORLD_1;
+        default:                            return -1;
+    }
+}
 
-    // Clear the LUT
-    for (keyCode = 0;  keyCode < 256;  keyCode++)
-        _glfw.x11.keyCodeLUT[keyCode] = -1;
+// Update the key code LUT entries for the specified range of key codes
+// Key codes mapped by key name are left alone, as they do not depend on the
+// keyboard layout
+//
+void _glfwUpdateKeyCodeRange(int first, int count)
+{
+    int keyCode;
 
-    // Use XKB to determine physical key locations independently of the current
-    // keyboard layout
+    if (first < 0)
+    {
+        count += first;
+        first = 0;
+    }
 
-    // Get keyboard description
-    descr = XkbGetKeyboard(_glfw.x11.display,
-                            XkbAllComponentsMask,
-                            XkbUseCoreKbd);
+    if (first + count > 256)
+        count = 256 - first;
 
-    // Find the X11 key code -> GLFW key code mapping
-    for (keyCode = descr->min_key_code; keyCode <= descr->max_key_code; ++keyCode)
+    for (keyCode = first;  keyCode < first + count;  keyCode++)
     {
-        // Get the key name
-        for (i = 0;  i < XkbKeyNameLength;  i++)
-            name[i] = descr->names->keys[keyCode].name[i];
-
-        name[XkbKeyNameLength] = 0;
-
-        // Map the key name to a GLFW key code. Note: We only map printable
-        // keys here, and we use the US keyboard layout. The rest of the
-        // keys (function keys) are mapped using traditional KeySym
-        // translations.
-        if (strcmp(name, "TLDE") == 0) keyCodeGLFW = GLFW_KEY_GRAVE_ACCENT;
-        else if (strcmp(name, "AE01") == 0) keyCodeGLFW = GLFW_KEY_1;
-        else if (strcmp(name, "AE02") == 0) keyCodeGLFW = GLFW_KEY_2;
-        else if (strcmp(name, "AE03") == 0) keyCodeGLFW = GLFW_KEY_3;
-        else if (strcmp(name, "AE04") == 0) keyCodeGLFW = GLFW_KEY_4;
-        else if (strcmp(name, "AE05") == 0) keyCodeGLFW = GLFW_KEY_5;
-        else if (strcmp(name, "AE06") == 0) keyCodeGLFW = GLFW_KEY_6;
-        else if (strcmp(name, "AE07") == 0) keyCodeGLFW = GLFW_KEY_7;
-        else if (strcmp(name, "AE08") == 0) keyCodeGLFW = GLFW_KEY_8;
-        else if (strcmp(name, "AE09") == 0) keyCodeGLFW = GLFW_KEY_9;
-        else if (strcmp(name, "AE10") == 0) keyCodeGLFW = GLFW_KEY_0;
-        else if (strcmp(name, "AE11") == 0) keyCodeGLFW = GLFW_KEY_MINUS;
-        else if (strcmp(name, "AE12") == 0) keyCodeGLFW = GLFW_KEY_EQUAL;
-        else if (strcmp(name, "AD01") == 0) keyCodeGLFW = GLFW_KEY_Q;
-        else if (strcmp(name, "AD02") == 0) keyCodeGLFW = GLFW_KEY_W;
-        else if (strcmp(name, "AD03") == 0) keyCodeGLFW = GLFW_KEY_E;
-        else if (strcmp(name, "AD04") == 0) keyCodeGLFW = GLFW_KEY_R;
-        else if (strcmp(name, "AD05") == 0) keyCodeGLFW = GLFW_KEY_T;
-        else if (strcmp(name, "AD06") == 0) keyCodeGLFW = GLFW_KEY_Y;
-        else if (strcmp(name, "AD07") == 0) keyCodeGLFW = GLFW_KEY_U;
-        else if (strcmp(name, "AD08") == 0) keyCodeGLFW = GLFW_KEY_I;
-        else if (strcmp(name, "AD09") == 0) keyCodeGLFW = GLFW_KEY_O;
-        else if (strcmp(name, "AD10") == 0) keyCodeGLFW = GLFW_KEY_P;
-        else if (strcmp(name, "AD11") == 0) keyCodeGLFW = GLFW_KEY_LEFT_BRACKET;
-        else if (strcmp(name, "AD12") == 0) keyCodeGLFW = GLFW_KEY_RIGHT_BRACKET;
-        else if (strcmp(name, "AC01") == 0) keyCodeGLFW = GLFW_KEY_A;
-        else if (strcmp(name, "AC02") == 0) keyCodeGLFW = GLFW_KEY_S;
-        else if (strcmp(name, "AC03") == 0) keyCodeGLFW = GLFW_KEY_D;
-        else if (strcmp(name, "AC04") == 0) keyCodeGLFW = GLFW_KEY_F;
-        else if (strcmp(name, "AC05") == 0) keyCodeGLFW = GLFW_KEY_G;
-        else if (strcmp(name, "AC06") == 0) keyCodeGLFW = GLFW_KEY_H;
-        else if (strcmp(name, "AC07") == 0) keyCodeGLFW = GLFW_KEY_J;
-        else if (strcmp(name, "AC08") == 0) keyCodeGLFW = GLFW_KEY_K;
-        else if (strcmp(name, "AC09") == 0) keyCodeGLFW = GLFW_KEY_L;
-        else if (strcmp(name, "AC10") == 0) keyCodeGLFW = GLFW_KEY_SEMICOLON;
-        else if (strcmp(name, "AC11") == 0) keyCodeGLFW = GLFW_KEY_APOSTROPHE;
-        else if (strcmp(name, "AB01") == 0) keyCodeGLFW = GLFW_KEY_Z;
-        else if (strcmp(name, "AB02") == 0) keyCodeGLFW = GLFW_KEY_X;
-        else if (strcmp(name, "AB03") == 0) keyCodeGLFW = GLFW_KEY_C;
-        else if (strcmp(name, "AB04") == 0) keyCodeGLFW = GLFW_KEY_V;
-        else if (strcmp(name, "AB05") == 0) keyCodeGLFW = GLFW_KEY_B;
-        else if (strcmp(name, "AB06") == 0) keyCodeGLFW = GLFW_KEY_N;
-        else if (strcmp(name, "AB07") == 0) keyCodeGLFW = GLFW_KEY_M;
-        else if (strcmp(name, "AB08") == 0) keyCodeGLFW = GLFW_KEY_COMMA;
-        else if (strcmp(name, "AB09") == 0) keyCodeGLFW = GLFW_KEY_PERIOD;
-        else if (strcmp(name, "AB10") == 0) keyCodeGLFW = GLFW_KEY_SLASH;
-        else if (strcmp(name, "BKSL") == 0) keyCodeGLFW = GLFW_KEY_BACKSLASH;
-        else if (strcmp(name, "LSGT") == 0) keyCodeGLFW = GLFW_KEY_WORLD_1;
-        else keyCodeGLFW = -1;
-
-        // Update the key code LUT
-        if ((keyCode >= 0) && (keyCode < 256))
-            _glfw.x11.keyCodeLUT[keyCode] = keyCodeGLFW;
+        if (_glfw.x11.keyNameLUT[keyCode] >= 0)
+            _glfw.x11.keyCodeLUT[keyCode] = _glfw.x11.keyNameLUT[keyCode];
+        else
+            _glfw.x11.keyCodeLUT[keyCode] = keyCodeToGLFWKeyCode(keyCode);
     }
+}
 
-    // Free the keyboard description
-    XkbFreeKeyboard(descr, 0, True);
+// Rebuild the key code LUT
+//
+void _glfwUpdateKeyCodeLUT(void)
+{
+    int keyCode;
+    XkbDescPtr descr;
 
-    // Translate the un-translated key codes using traditional X11 KeySym
-    // lookups
     for (keyCode = 0;  keyCode < 256;  keyCode++)
+        _glfw.x11.keyNameLUT[keyCode] = -1;
+
+    // Use XKB to determine physical key locations independently of the current
+    // keyboard layout.  Only the key code range and the key names are needed.
+    descr = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
+    if (descr)
     {
-        if (_glfw.x11.keyCodeLUT[keyCode] < 0)
-            _glfw.x11.keyCodeLUT[keyCode] = keyCodeToGLFWKeyCode(keyCode);
+        if (XkbGetNames(_glfw.x11.display, XkbKeyNamesMask, descr) == Success)
+        {
+            for (keyCode = descr->min_key_code;
+                 keyCode <= descr->max_key_code;
+                 keyCode++)
+            {
+                const unsigned char* name =
+                    (const unsigned char*) descr->names->keys[keyCode].name;
+
+                _glfw.x11.keyNameLUT[keyCode] =
+                    keyNameToGLFWKeyCode(KEY_NAME(name[0], name[1],
+                                                  name[2], name[3]));
+            }
+        }
+
+        XkbFreeKeyboard(descr, 0, True);
     }
+
+    // Translate the remaining key codes using traditional X11 KeySym lookups
+    _glfwUpdateKeyCodeRange(0, 256);
+}
+
+// Find or create all atoms used by GLFW with a single round-trip
+//
+static void internAtoms(void)
+{
+    struct {
+        char* name;
+        Atom* atom;
+    } table[] = {
+        { "WM_STATE", &_glfw.x11.WM_STATE },
+        { "WM_DELETE_WINDOW", &_glfw.x11.WM_DELETE_WINDOW },
+        { "_NET_SUPPORTING_WM_CHECK", &_glfw.x11.NET_SUPPORTING_WM_CHECK },
+        { "_NET_SUPPORTED", &_glfw.x11.NET_SUPPORTED },
+        { "_NET_WM_STATE", &_glfw.x11.NET_WM_STATE },
+        { "_NET_WM_STATE_FULLSCREEN", &_glfw.x11.NET_WM_STATE_FULLSCREEN },
+        { "_NET_WM_NAME", &_glfw.x11.NET_WM_NAME },
+        { "_NET_WM_ICON_NAME", &_glfw.x11.NET_WM_ICON_NAME },
+        { "_NET_WM_PING", &_glfw.x11.NET_WM_PING },
+        { "_NET_ACTIVE_WINDOW", &_glfw.x11.NET_ACTIVE_WINDOW },
+        { "UTF8_STRING", &_glfw.x11.UTF8_STRING },
+        { "COMPOUND_STRING", &_glfw.x11.COMPOUND_STRING },
+        { "GLFW_SELECTION", &_glfw.x11.selection.property },
+        { "TARGETS", &_glfw.x11.TARGETS },
+        { "INCR", &_glfw.x11.INCR },
+        { "CLIPBOARD", &_glfw.x11.CLIPBOARD }
+    };
+
+    int i;
+    const int count = sizeof(table) / sizeof(table[0]);
+    char* names[sizeof(table) / sizeof(table[0])];
+    Atom atoms[sizeof(table) / sizeof(table[0])];
+
+    for (i = 0;  i < count;  i++)
+        names[i] = table[i].name;
+
+    XInternAtoms(_glfw.x11.display, names, count, False, atoms);
+
+    for (i = 0;  i < count;  i++)
+        *table[i].atom = atoms[i];
 }
 
 // Check whether the specified atom is supported
 //
 static Atom getSupportedAtom(Atom* supportedAtoms,
                              unsigned long atomCount,
-                             const char* atomName)
+                             Atom atom)
 {
-    Atom atom = XInternAtom(_glfw.x11.display, atomName, True);
-    if (atom != None)
-    {
-        unsigned long i;
+    unsigned long i;
 
-        for (i = 0;  i < atomCount;  i++)
-        {
-            if (supportedAtoms[i] == atom)
-                return atom;
-        }
+    for (i = 0;  i < atomCount;  i++)
+    {
+        if (supportedAtoms[i] == atom)
+            return atom;
     }
 
     return None;
@@ -339,16 +406,25 @@ static void detectEWMH(void)
 {
     Window* windowFromRoot = NULL;
     Window* windowFromChild = NULL;
-
-    // First we need a couple of atoms, which should already be there
-    Atom supportingWmCheck =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTING_WM_CHECK", True);
-    Atom wmSupported =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTED", True);
-    if (supportingWmCheck == None || wmSupported == None)
-        return;
-
-    // Then we look for the _NET_SUPPORTING_WM_CHECK property of the root window
+    Atom supportingWmCheck = _glfw.x11.NET_SUPPORTING_WM_CHECK;
+    Atom wmSupported = _glfw.x11.NET_SUPPORTED;
+
+    // The EWMH atoms are only kept if the window manager supports them
+    Atom wmState = _glfw.x11.NET_WM_STATE;
+    Atom wmStateFullscreen = _glfw.x11.NET_WM_STATE_FULLSCREEN;
+    Atom wmName = _glfw.x11.NET_WM_NAME;
+    Atom wmIconName = _glfw.x11.NET_WM_ICON_NAME;
+    Atom wmPing = _glfw.x11.NET_WM_PING;
+    Atom activeWindow = _glfw.x11.NET_ACTIVE_WINDOW;
+
+    _glfw.x11.NET_WM_STATE = None;
+    _glfw.x11.NET_WM_STATE_FULLSCREEN = None;
+    _glfw.x11.NET_WM_NAME = None;
+    _glfw.x11.NET_WM_ICON_NAME = None;
+    _glfw.x11.NET_WM_PING = None;
+    _glfw.x11.NET_ACTIVE_WINDOW = None;
+
+    // We look for the _NET_SUPPORTING_WM_CHECK property of the root window
     if (_glfwGetWindowProperty(_glfw.x11.root,
                                supportingWmCheck,
                                XA_WINDOW,
@@ -396,22 +472,22 @@ static void detectEWMH(void)
     // See which of the atoms we support that are supported by the WM
 
     _glfw.x11.NET_WM_STATE =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE");
+        getSupportedAtom(supportedAtoms, atomCount, wmState);
 
     _glfw.x11.NET_WM_STATE_FULLSCREEN =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_FULLSCREEN");
+        getSupportedAtom(supportedAtoms, atomCount, wmStateFullscreen);
 
     _glfw.x11.NET_WM_NAME =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_NAME");
+        getSupportedAtom(supportedAtoms, atomCount, wmName);
 
     _glfw.x11.NET_WM_ICON_NAME =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_ICON_NAME");
+        getSupportedAtom(supportedAtoms, atomCount, wmIconName);
 
     _glfw.x11.NET_WM_PING =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_PING");
+        getSupportedAtom(supportedAtoms, atomCount, wmPing);
 
     _glfw.x11.NET_ACTIVE_WINDOW =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_ACTIVE_WINDOW");
+        getSupportedAtom(supportedAtoms, atomCount, activeWindow);
 
     XFree(supportedAtoms);
 
@@ -435,18 +511,10 @@ static GLboolean initDisplay(void)
     // this choice and hope for the best
     _glfw.x11.screen = DefaultScreen(_glfw.x11.display);
     _glfw.x11.root = RootWindow(_glfw.x11.display, _glfw.x11.screen);
+    _glfw.x11.context = XUniqueContext();
 
-    // Find or create window manager atoms
-    _glfw.x11.WM_STATE = XInternAtom(_glfw.x11.display, "WM_STATE", False);
-    _glfw.x11.WM_DELETE_WINDOW = XInternAtom(_glfw.x11.display,
-                                             "WM_DELETE_WINDOW",
-                                             False);
-
-    // Check for XF86VidMode extension
-    _glfw.x11.vidmode.available =
-        XF86VidModeQueryExtension(_glfw.x11.display,
-                                  &_glfw.x11.vidmode.eventBase,
-                                  &_glfw.x11.vidmode.errorBase);
+    // Find or create all atoms at once
+    internAtoms();
 
     // Check for RandR extension
     _glfw.x11.randr.available =
@@ -502,29 +570,56 @@ static GLboolean initDisplay(void)
         return GL_FALSE;
     }
 
-    // Update the key code LUT
-    // FIXME: We should listen to XkbMapNotify events to track changes to
-    // the keyboard mapping.
-    updateKeyCodeLUT();
+#if defined(_GLFW_HAS_XINPUT)
+    // Check for XInput2 extension, used for raw motion in captured cursor mode
+    if (XQueryExtension(_glfw.x11.display,
+                        "XInputExtension",
+                        &_glfw.x11.xi.majorOpcode,
+                        &_glfw.x11.xi.eventBase,
+                        &_glfw.x11.xi.errorBase))
+    {
+        _glfw.x11.xi.versionMajor = 2;
+        _glfw.x11.xi.versionMinor = 0;
 
-    // Detect whether an EWMH-conformant window manager is running
-    detectEWMH();
+        if (XIQueryVersion(_glfw.x11.display,
+                           &_glfw.x11.xi.versionMajor,
+                           &_glfw.x11.xi.versionMinor) == Success)
+        {
+            _glfw.x11.xi.available = GL_TRUE;
+        }
+    }
+#endif // _GLFW_HAS_XINPUT
+
+#if defined(_GLFW_HAS_XPRESENT)
+    // Check for Present extension, used for presentation timing
+    if (XPresentQueryExtension(_glfw.x11.display,
+                               &_glfw.x11.present.majorOpcode,
+                               &_glfw.x11.present.eventBase,
+                               &_glfw.x11.present.errorBase))
+    {
+        if (XPresentQueryVersion(_glfw.x11.display,
+                                 &_glfw.x11.present.versionMajor,
+                                 &_glfw.x11.present.versionMinor))
+        {
+            _glfw.x11.present.available = GL_TRUE;
+        }
+    }
+#endif // _GLFW_HAS_XPRESENT
 
-    // Find or create string format atoms
-    _glfw.x11.UTF8_STRING =
-        XInternAtom(_glfw.x11.display, "UTF8_STRING", False);
-    _glfw.x11.COMPOUND_STRING =
-        XInternAtom(_glfw.x11.display, "COMPOUND_STRING", False);
+    // Track changes to the keyboard mapping, so that the key code LUT can be
+    // kept up to date
+    XkbSelectEvents(_glfw.x11.display, XkbUseCoreKbd,
+                    XkbNewKeyboardNotifyMask, XkbNewKeyboardNotifyMask);
+    XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd, XkbMapNotify,
+                          XkbKeySymsMask, XkbKeySymsMask);
 
-    // Find or create selection property atom
-    _glfw.x11.selection.property =
-        XInternAtom(_glfw.x11.display, "GLFW_SELECTION", False);
+    // Update the key code LUT
+    _glfwUpdateKeyCodeLUT();
 
-    // Find or create standard clipboard atoms
-    _glfw.x11.TARGETS = XInternAtom(_glfw.x11.display, "TARGETS", False);
-    _glfw.x11.CLIPBOARD = XInternAtom(_glfw.x11.display, "CLIPBOARD", False);
+    // Detect whether an EWMH-conformant window manager is running
+    detectEWMH();
 
-    // Find or create selection target atoms
+    // Set up selection target atoms
     _glfw.x11.selection.formats[_GLFW_CLIPBOARD_FORMAT_UTF8] =
         _glfw.x11.UTF8_STRING;
     _glfw.x11.selection.formats[_GLFW_CLIPBOARD_FORMAT_COMPOUND] =
@@ -532,6 +627,18 @@ static GLboolean initDisplay(void)
     _glfw.x11.selection.formats[_GLFW_CLIPBOARD_FORMAT_STRING] =
         XA_STRING;
 
+    // Strings larger than this are sent incrementally (ICCCM section 2.5)
+    {
+        long maxRequestSize = XExtendedMaxRequestSize(_glfw.x11.display);
+        if (!maxRequestSize)
+            maxRequestSize = XMaxRequestSize(_glfw.x11.display);
+
+        // The size is in four-byte units and includes the request header
+        _glfw.x11.selection.chunkSize = maxRequestSize * 4 - 100;
+        if (_glfw.x11.selection.chunkSize > _GLFW_SELECTION_CHUNK_SIZE)
+            _glfw.x11.selection.chunkSize = _GLFW_SELECTION_CHUNK_SIZE;
+    }
+
     return GL_TRUE;
 }
 
@@ -563,6 +670,32 @@ static Cursor createNULLCursor(void)
     return cursor;
 }
 
+// Create the self-pipe used to wake up the event loop from other threads
+//
+static GLboolean initEmptyEventPipe(void)
+{
+    int i;
+
+    if (pipe(_glfw.x11.emptyEventPipe) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create empty event pipe");
+        return GL_FALSE;
+    }
+
+    for (i = 0;  i < 2;  i++)
+    {
+        const int fd = _glfw.x11.emptyEventPipe[i];
+
+        // Neither end may block, as the write end is used from arbitrary
+        // threads and the read end is drained until empty
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, fcntl(fd, F_GETFD, 0) | FD_CLOEXEC);
+    }
+
+    return GL_TRUE;
+}
+
 // Terminate X11 display
 //
 static void terminateDisplay(void)
@@ -586,6 +719,9 @@ int _glfwPlatformInit(void)
     if (!initDisplay())
         return GL_FALSE;
 
+    if (!initEmptyEventPipe())
+        return GL_FALSE;
+
     _glfwInitGammaRamp();
 
     if (!_glfwInitContextAPI())
@@ -598,6 +734,8 @@ int _glfwPlatformInit(void)
 
     _glfwInitTimer();
 
+    _glfwInitUnicode();
+
     return GL_TRUE;
 }
 
@@ -615,6 +753,12 @@ void _glfwPlatformTerminate(void)
 
     terminateDisplay();
 
+    if (_glfw.x11.emptyEventPipe[0] || _glfw.x11.emptyEventPipe[1])
+    {
+        close(_glfw.x11.emptyEventPipe[0]);
+        close(_glfw.x11.emptyEventPipe[1]);
+    }
+
     if (_glfw.x11.selection.string)
         free(_glfw.x11.selection.string);
 }
@@ -639,6 +783,12 @@ const char* _glfwPlatformGetVersionString(void)
 #if defined(_POSIX_TIMERS) && defined(_POSIX_MONOTONIC_CLOCK)
         " clock_gettime"
 #endif
+#if defined(_GLFW_HAS_XINPUT)
+        " XInput2"
+#endif
+#if defined(_GLFW_HAS_XPRESENT)
+        " Present"
+#endif
 #if defined(__linux__)
         " /dev/js"
 #endif
@@ -35,9 +35,11 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <fcntl.h>
 #include <errno.h>
-#include <regex.h>
 #include <dirent.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,11 +47,138 @@
 #endif // __linux__
 
 
+// Begins reading the published state of the specified joystick
+// Returns the sequence number to pass to endStateRead
+//
+static unsigned int beginStateRead(int joy)
+{
+    unsigned int sequence;
+
+    // An odd sequence number means that a change is in progress
+    while ((sequence = _glfw.x11.joystick[joy].sequence) & 1)
+        ;
+
+    __sync_synchronize();
+    return sequence;
+}
+
+// Ends reading the published state of the specified joystick
+// Returns GL_FALSE if the state changed while it was read, in which case it
+// must be read again
+//
+static GLboolean endStateRead(int joy, unsigned int sequence)
+{
+    __sync_synchronize();
+    return _glfw.x11.joystick[joy].sequence == sequence;
+}
+
+#ifdef __linux__
+
+// Older kernel headers only provide the event time as a struct timeval
+#ifndef input_event_sec
+ #define input_event_sec time.tv_sec
+ #define input_event_usec time.tv_usec
+#endif
+
+// Returns whether the specified bit is set in a kernel bit array
+//
+static GLboolean isBitSet(int bit, const unsigned long* bits)
+{
+    const int size = (int) (sizeof(unsigned long) * 8);
+    return (bits[bit / size] >> (bit % size)) & 1;
+}
+
+// Returns whether the specified device file name starts with the specified
+// prefix followed only by digits
+//
+static GLboolean isDeviceName(const char* name, const char* prefix)
+{
+    const size_t length = strlen(prefix);
+
+    if (strncmp(name, prefix, length) != 0 || name[length] == '\0')
+        return GL_FALSE;
+
+    for (name += length;  *name;  name++)
+    {
+        if (*name < '0' || *name > '9')
+            return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
+
+// Returns whether the specified device file name is that of a joystick or
+// event device
+//
+static GLboolean isJoystickName(const char* name)
+{
+    return isDeviceName(name, "js") || isDeviceName(name, "event");
+}
+
+// Returns the sysfs path of the input device behind the specified device file,
+// which is shared by its joystick and event device files
+//
+static char* getInputDevice(const char* path)
+{
+    char link[64];
+    char* device;
+    const char* name = strrchr(path, '/') + 1;
+
+    snprintf(link, sizeof(link), "/sys/class/input/%s/device", name);
+
+    device = realpath(link, NULL);
+    if (!device)
+    {
+        // Without sysfs the device file path is the best identifier
+        device = strdup(path);
+    }
+
+    return device;
+}
+
+// Allocates the state of a joystick whose device has been opened
+//
+static GLboolean initJoystick(int joy, int fd, const char* path,
+                              const char* name, int numAxes, int numButtons)
+{
+    _glfw.x11.joystick[joy].fd = fd;
+    _glfw.x11.joystick[joy].numAxes = numAxes;
+    _glfw.x11.joystick[joy].numButtons = numButtons;
+
+    _glfw.x11.joystick[joy].axis = (float*) calloc(numAxes, sizeof(float));
+    _glfw.x11.joystick[joy].button = (unsigned char*) calloc(numButtons, 1);
+    _glfw.x11.joystick[joy].events = (GLFWjoystickevent*)
+        malloc(sizeof(GLFWjoystickevent) * _GLFW_JOYSTICK_EVENT_COUNT);
+
+    if ((numAxes && !_glfw.x11.joystick[joy].axis) ||
+        (numButtons && !_glfw.x11.joystick[joy].button) ||
+        !_glfw.x11.joystick[joy].events)
+    {
+        free(_glfw.x11.joystick[joy].events);
+        free(_glfw.x11.joystick[joy].button);
+        free(_glfw.x11.joystick[joy].axis);
+        close(fd);
+
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GL_FALSE;
+    }
+
+    _glfw.x11.joystick[joy].eventsWritten = 0;
+    _glfw.x11.joystick[joy].eventsRead = 0;
+
+    _glfw.x11.joystick[joy].name = strdup(name);
+    _glfw.x11.joystick[joy].path = strdup(path);
+    _glfw.x11.joystick[joy].device = getInputDevice(path);
+    _glfw.x11.joystick[joy].released = GL_FALSE;
+
+    _glfw.x11.joystick[joy].present = GL_TRUE;
+    return GL_TRUE;
+}
+
 // Attempt to open the specified joystick device
 //
 static int openJoystickDevice(int joy, const char* path)
 {
-#ifdef __linux__
     char numAxes, numButtons;
     char name[256];
     int fd, version;
@@ -58,8 +187,6 @@ static int openJoystickDevice(int joy, const char* path)
     if (fd == -1)
         return GL_FALSE;
 
-    _glfw.x11.joystick[joy].fd = fd;
-
     // Verify that the joystick driver version is at least 1.0
     ioctl(fd, JSIOCGVERSION, &version);
     if (version < 0x010000)
@@ -72,97 +199,617 @@ static int openJoystickDevice(int joy, const char* path)
     if (ioctl(fd, JSIOCGNAME(sizeof(name)), name) < 0)
         strncpy(name, "Unknown", sizeof(name));
 
-    _glfw.x11.joystick[joy].name = strdup(name);
-
     ioctl(fd, JSIOCGAXES, &numAxes);
-    _glfw.x11.joystick[joy].numAxes = (int) numAxes;
-
     ioctl(fd, JSIOCGBUTTONS, &numButtons);
-    _glfw.x11.joystick[joy].numButtons = (int) numButtons;
 
-    _glfw.x11.joystick[joy].axis = (float*) malloc(sizeof(float) * numAxes);
-    if (_glfw.x11.joystick[joy].axis == NULL)
+    _glfw.x11.joystick[joy].evdev = GL_FALSE;
+
+    return initJoystick(joy, fd, path, name,
+                        (unsigned char) numAxes, (unsigned char) numButtons);
+}
+
+// Attempt to open the specified event device as a joystick
+//
+static int openEvdevDevice(int joy, const char* path)
+{
+    int i, fd, numAxes = 0, numButtons = 0;
+    char name[256];
+    unsigned long evBits[(EV_CNT + 8 * sizeof(long) - 1) / (8 * sizeof(long))];
+    unsigned long keyBits[(KEY_CNT + 8 * sizeof(long) - 1) / (8 * sizeof(long))];
+    unsigned long absBits[(ABS_CNT + 8 * sizeof(long) - 1) / (8 * sizeof(long))];
+    GLboolean joystick = GL_FALSE;
+
+    fd = open(path, O_RDONLY | O_NONBLOCK);
+    if (fd == -1)
+        return GL_FALSE;
+
+    memset(evBits, 0, sizeof(evBits));
+    memset(keyBits, 0, sizeof(keyBits));
+    memset(absBits, 0, sizeof(absBits));
+
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(evBits)), evBits) < 0 ||
+        ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 ||
+        ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0)
     {
         close(fd);
-
-        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
         return GL_FALSE;
     }
 
-    _glfw.x11.joystick[joy].button = (unsigned char*) malloc(numButtons);
-    if (_glfw.x11.joystick[joy].button == NULL)
+    // Only devices with absolute axes and joystick or gamepad buttons are
+    // considered joysticks, which excludes mice, touchpads and keyboards
+    for (i = BTN_JOYSTICK;  i < BTN_DIGI;  i++)
+    {
+        if (isBitSet(i, keyBits))
+            joystick = GL_TRUE;
+    }
+
+    if (!isBitSet(EV_ABS, evBits) || !joystick)
     {
-        free(_glfw.x11.joystick[joy].axis);
         close(fd);
+        return GL_FALSE;
+    }
 
-        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+    // Event times must be on the clock of the GLFW timer to be translated
+    if (_glfw.x11.timer.monotonic)
+    {
+        int clock = CLOCK_MONOTONIC;
+
+        if (ioctl(fd, EVIOCSCLOCKID, &clock) < 0)
+        {
+            close(fd);
+            return GL_FALSE;
+        }
+    }
+
+    if (ioctl(fd, EVIOCGNAME(sizeof(name)), name) < 0)
+        strncpy(name, "Unknown", sizeof(name));
+
+    // Number buttons and axes in the same order as the joystick driver
+    memset(_glfw.x11.joystick[joy].keyMap, 0,
+           sizeof(_glfw.x11.joystick[joy].keyMap));
+    memset(_glfw.x11.joystick[joy].absMap, 0,
+           sizeof(_glfw.x11.joystick[joy].absMap));
+
+    for (i = BTN_MISC;  i < KEY_CNT;  i++)
+    {
+        if (isBitSet(i, keyBits))
+            _glfw.x11.joystick[joy].keyMap[i] = ++numButtons;
+    }
+
+    for (i = 0;  i < BTN_MISC;  i++)
+    {
+        if (isBitSet(i, keyBits))
+            _glfw.x11.joystick[joy].keyMap[i] = ++numButtons;
+    }
+
+    for (i = 0;  i < ABS_CNT;  i++)
+    {
+        if (!isBitSet(i, absBits))
+            continue;
+
+        if (ioctl(fd, EVIOCGABS(i), &_glfw.x11.joystick[joy].absInfo[i]) < 0)
+            continue;
+
+        _glfw.x11.joystick[joy].absMap[i] = ++numAxes;
+    }
+
+    _glfw.x11.joystick[joy].evdev = GL_TRUE;
+    _glfw.x11.joystick[joy].dropped = GL_FALSE;
+
+    return initJoystick(joy, fd, path, name, numAxes, numButtons);
+}
+
+// Closes the device of the specified joystick and frees its slot
+//
+static void closeJoystickDevice(int joy)
+{
+    close(_glfw.x11.joystick[joy].fd);
+    free(_glfw.x11.joystick[joy].axis);
+    free(_glfw.x11.joystick[joy].button);
+    free(_glfw.x11.joystick[joy].name);
+    free(_glfw.x11.joystick[joy].events);
+    free(_glfw.x11.joystick[joy].path);
+    free(_glfw.x11.joystick[joy].device);
+
+    // The sequence number is kept, as readers may still be comparing it
+    _glfw.x11.joystick[joy].present = GL_FALSE;
+    _glfw.x11.joystick[joy].released = GL_FALSE;
+    _glfw.x11.joystick[joy].numAxes = 0;
+    _glfw.x11.joystick[joy].numButtons = 0;
+    _glfw.x11.joystick[joy].axis = NULL;
+    _glfw.x11.joystick[joy].button = NULL;
+    _glfw.x11.joystick[joy].name = NULL;
+    _glfw.x11.joystick[joy].events = NULL;
+    _glfw.x11.joystick[joy].path = NULL;
+    _glfw.x11.joystick[joy].device = NULL;
+}
+
+// Begins a change of the published state of the specified joystick
+//
+static void beginStateWrite(int joy)
+{
+    _glfw.x11.joystick[joy].sequence++;
+    __sync_synchronize();
+}
+
+// Ends a change of the published state of the specified joystick
+//
+static void endStateWrite(int joy)
+{
+    __sync_synchronize();
+    _glfw.x11.joystick[joy].sequence++;
+}
+
+// Adds an event to the event queue of the specified joystick, discarding the
+// oldest event if the queue is full
+//
+static void queueJoystickEvent(int joy, int type, int index, double time)
+{
+    GLFWjoystickevent* event = _glfw.x11.joystick[joy].events +
+        _glfw.x11.joystick[joy].eventsWritten % _GLFW_JOYSTICK_EVENT_COUNT;
+
+    event->type = type;
+    event->index = index;
+    event->value = 0.0f;
+    event->action = 0;
+    event->time = time;
+
+    if (type == GLFW_JOYSTICK_AXIS_EVENT)
+        event->value = _glfw.x11.joystick[joy].axis[index];
+    else
+        event->action = _glfw.x11.joystick[joy].button[index];
+
+    // Publish the event only once it has been written
+    __sync_synchronize();
+    _glfw.x11.joystick[joy].eventsWritten++;
+}
+
+// Sets the value of the specified event device axis, normalized to the range
+// reported by the device
+//
+static void setEvdevAxis(int joy, int code, int value)
+{
+    const int index = _glfw.x11.joystick[joy].absMap[code] - 1;
+    const struct input_absinfo* info = _glfw.x11.joystick[joy].absInfo + code;
+    float normalized = 0.0f;
+
+    if (info->maximum > info->minimum)
+    {
+        normalized = 2.0f * (float) (value - info->minimum) /
+                     (float) (info->maximum - info->minimum) - 1.0f;
+    }
+
+    // Y axes grow downward, but GLFW wants positive = up/forward
+    if (code == ABS_Y || code == ABS_RY ||
+        (code >= ABS_HAT0X && code <= ABS_HAT3Y && (code - ABS_HAT0X) & 1))
+    {
+        normalized = -normalized;
+    }
+
+    _glfw.x11.joystick[joy].axis[index] = normalized;
+}
+
+// Reads the current state of all buttons and axes of the specified event
+// device, after events were dropped by the kernel
+//
+static void syncEvdevState(int joy)
+{
+    int i;
+    unsigned long keyBits[(KEY_CNT + 8 * sizeof(long) - 1) / (8 * sizeof(long))];
+    struct input_absinfo absInfo[ABS_CNT];
+    GLboolean absValid[ABS_CNT];
+    const int fd = _glfw.x11.joystick[joy].fd;
+
+    // The device is queried before the published state is changed, so that
+    // readers are not kept waiting on the ioctls
+    memset(keyBits, 0, sizeof(keyBits));
+    ioctl(fd, EVIOCGKEY(sizeof(keyBits)), keyBits);
+
+    for (i = 0;  i < ABS_CNT;  i++)
+    {
+        absValid[i] = _glfw.x11.joystick[joy].absMap[i] &&
+                      ioctl(fd, EVIOCGABS(i), absInfo + i) == 0;
+    }
+
+    beginStateWrite(joy);
+
+    for (i = 0;  i < KEY_CNT;  i++)
+    {
+        const int index = _glfw.x11.joystick[joy].keyMap[i] - 1;
+        if (index >= 0)
+        {
+            _glfw.x11.joystick[joy].button[index] =
+                isBitSet(i, keyBits) ? GLFW_PRESS : GLFW_RELEASE;
+        }
+    }
+
+    for (i = 0;  i < ABS_CNT;  i++)
+    {
+        if (absValid[i])
+            setEvdevAxis(joy, i, absInfo[i].value);
+    }
+
+    endStateWrite(joy);
+}
+
+// Processes a batch of events read from the specified event device
+// This is called inside a change of the published state
+//
+static void processEvdevEvents(int joy, const struct input_event* events,
+                               int count)
+{
+    int i, index;
+
+    for (i = 0;  i < count;  i++)
+    {
+        const struct input_event* e = events + i;
+        const double time = _glfwTranslateClockTime(e->input_event_sec,
+                                                     e->input_event_usec);
+
+        if (e->type == EV_SYN)
+        {
+            if (e->code == SYN_DROPPED)
+                _glfw.x11.joystick[joy].dropped = GL_TRUE;
+            else if (e->code == SYN_REPORT && _glfw.x11.joystick[joy].dropped)
+            {
+                // The events since the last report are incomplete, so the
+                // state is read directly from the device instead
+                // The device is queried outside of the state change
+                endStateWrite(joy);
+                syncEvdevState(joy);
+                beginStateWrite(joy);
+                _glfw.x11.joystick[joy].dropped = GL_FALSE;
+            }
+
+            continue;
+        }
+
+        if (_glfw.x11.joystick[joy].dropped)
+            continue;
+
+        if (e->type == EV_KEY && e->code < KEY_CNT)
+        {
+            index = _glfw.x11.joystick[joy].keyMap[e->code] - 1;
+            if (index < 0)
+                continue;
+
+            _glfw.x11.joystick[joy].button[index] =
+                e->value ? GLFW_PRESS : GLFW_RELEASE;
+
+            queueJoystickEvent(joy, GLFW_JOYSTICK_BUTTON_EVENT, index, time);
+        }
+        else if (e->type == EV_ABS && e->code < ABS_CNT)
+        {
+            index = _glfw.x11.joystick[joy].absMap[e->code] - 1;
+            if (index < 0)
+                continue;
+
+            setEvdevAxis(joy, e->code, e->value);
+
+            queueJoystickEvent(joy, GLFW_JOYSTICK_AXIS_EVENT, index, time);
+        }
+    }
+}
+
+// Processes a batch of events read from the specified joystick device
+// This is called inside a change of the published state
+//
+static void processJoystickEvents(int joy, const struct js_event* events,
+                                  int count)
+{
+    int i;
+
+    for (i = 0;  i < count;  i++)
+    {
+        struct js_event e = events[i];
+
+        // Initial state events describe the state at the time the device was
+        // opened and are not queued
+        const GLboolean initial = (e.type & JS_EVENT_INIT) != 0;
+        e.type &= ~JS_EVENT_INIT;
+
+        switch (e.type)
+        {
+            case JS_EVENT_AXIS:
+                _glfw.x11.joystick[joy].axis[e.number] =
+                    (float) e.value / 32767.0f;
+
+                // We need to change the sign for the Y axes, so that
+                // positive = up/forward, according to the GLFW spec.
+                if (e.number & 1)
+                {
+                    _glfw.x11.joystick[joy].axis[e.number] =
+                        -_glfw.x11.joystick[joy].axis[e.number];
+                }
+
+                if (!initial)
+                {
+                    queueJoystickEvent(joy, GLFW_JOYSTICK_AXIS_EVENT, e.number,
+                                       _glfwTranslateJoystickTime(e.time));
+                }
+
+                break;
+
+            case JS_EVENT_BUTTON:
+                _glfw.x11.joystick[joy].button[e.number] =
+                    e.value ? GLFW_PRESS : GLFW_RELEASE;
+
+                if (!initial)
+                {
+                    queueJoystickEvent(joy, GLFW_JOYSTICK_BUTTON_EVENT, e.number,
+                                       _glfwTranslateJoystickTime(e.time));
+                }
+
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+// Reads and processes all queued events of the specified joystick
+//
+static void readJoystickEvents(int joy)
+{
+    ssize_t result;
+    union {
+        struct js_event js[_GLFW_JOYSTICK_READ_COUNT];
+        struct input_event evdev[_GLFW_JOYSTICK_READ_COUNT];
+    } events;
+    const ssize_t size = _glfw.x11.joystick[joy].evdev ?
+                         sizeof(events.evdev) : sizeof(events.js);
+
+    // Read all queued events (non-blocking), as many at a time as fit
+    // Only processing the events changes the published state, so readers are
+    // never kept waiting on the device
+    for (;;)
+    {
+        result = read(_glfw.x11.joystick[joy].fd, &events, size);
+        if (result == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == ENODEV)
+            {
+                beginStateWrite(joy);
+                _glfw.x11.joystick[joy].present = GL_FALSE;
+                endStateWrite(joy);
+            }
+
+            break;
+        }
+
+        beginStateWrite(joy);
+
+        if (_glfw.x11.joystick[joy].evdev)
+        {
+            processEvdevEvents(joy, events.evdev,
+                               (int) (result / sizeof(struct input_event)));
+        }
+        else
+        {
+            processJoystickEvents(joy, events.js,
+                                  (int) (result / sizeof(struct js_event)));
+        }
+
+        endStateWrite(joy);
+
+        // A partial buffer means the queue has been emptied
+        if (result < size)
+            break;
+    }
+}
+
+// Entry point of the joystick reader thread
+//
+static void* joystickThreadMain(void* arg)
+{
+    for (;;)
+    {
+        int i, count;
+        struct epoll_event events[GLFW_JOYSTICK_LAST + 2];
+
+        count = epoll_wait(_glfw.x11.joystickThread.epoll,
+                           events, sizeof(events) / sizeof(events[0]), -1);
+        if (count == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return NULL;
+        }
+
+        for (i = 0;  i < count;  i++)
+        {
+            const int joy = (int) events[i].data.u32;
+
+            if (joy > GLFW_JOYSTICK_LAST)
+            {
+                // The stop event was signaled by the main thread
+                return NULL;
+            }
+
+            readJoystickEvents(joy);
+
+            if (!_glfw.x11.joystick[joy].present)
+            {
+                epoll_ctl(_glfw.x11.joystickThread.epoll, EPOLL_CTL_DEL,
+                          _glfw.x11.joystick[joy].fd, NULL);
+
+                // Hand the slot back to the main thread to be closed
+                __sync_synchronize();
+                _glfw.x11.joystick[joy].released = GL_TRUE;
+                _glfwPlatformPostEmptyEvent();
+            }
+        }
+    }
+}
+
+// Starts the joystick reader thread
+//
+static GLboolean startJoystickThread(void)
+{
+    int i;
+    struct epoll_event event;
+
+    _glfw.x11.joystickThread.epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (_glfw.x11.joystickThread.epoll == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create joystick epoll instance");
         return GL_FALSE;
     }
 
-    _glfw.x11.joystick[joy].present = GL_TRUE;
-#endif // __linux__
+    _glfw.x11.joystickThread.stop = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_glfw.x11.joystickThread.stop == -1)
+    {
+        close(_glfw.x11.joystickThread.epoll);
+
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create joystick thread stop event");
+        return GL_FALSE;
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = GLFW_JOYSTICK_LAST + 1;
+    epoll_ctl(_glfw.x11.joystickThread.epoll, EPOLL_CTL_ADD,
+              _glfw.x11.joystickThread.stop, &event);
 
+    for (i = 0;  i <= GLFW_JOYSTICK_LAST;  i++)
+    {
+        if (!_glfw.x11.joystick[i].present)
+            continue;
+
+        event.data.u32 = i;
+        epoll_ctl(_glfw.x11.joystickThread.epoll, EPOLL_CTL_ADD,
+                  _glfw.x11.joystick[i].fd, &event);
+    }
+
+    if (pthread_create(&_glfw.x11.joystickThread.thread, NULL,
+                       joystickThreadMain, NULL) != 0)
+    {
+        close(_glfw.x11.joystickThread.stop);
+        close(_glfw.x11.joystickThread.epoll);
+
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create joystick thread");
+        return GL_FALSE;
+    }
+
+    _glfw.x11.joystickThread.running = GL_TRUE;
     return GL_TRUE;
 }
 
-// Polls for and processes events for all present joysticks
+// Stops the joystick reader thread
+//
+static void stopJoystickThread(void)
+{
+    const uint64_t value = 1;
+
+    if (write(_glfw.x11.joystickThread.stop, &value, sizeof(value)) !=
+        sizeof(value))
+    {
+        // The thread cannot be woken up, so leave it waiting for joystick
+        // events rather than freeing state it might still be using
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to stop joystick thread");
+        return;
+    }
+
+    pthread_join(_glfw.x11.joystickThread.thread, NULL);
+
+    close(_glfw.x11.joystickThread.stop);
+    close(_glfw.x11.joystickThread.epoll);
+
+    _glfw.x11.joystickThread.running = GL_FALSE;
+}
+
+#endif // __linux__
+
+// Polls for and processes events for all present joysticks, unless the
+// joystick thread is already doing so
 //
 static void pollJoystickEvents(void)
 {
 #ifdef __linux__
     int i;
-    ssize_t result;
-    struct js_event e;
+
+    if (_glfw.x11.joystickThread.running)
+        return;
 
     for (i = 0;  i <= GLFW_JOYSTICK_LAST;  i++)
     {
         if (!_glfw.x11.joystick[i].present)
             continue;
 
-        // Read all queued events (non-blocking)
-        for (;;)
-        {
-            errno = 0;
-            result = read(_glfw.x11.joystick[i].fd, &e, sizeof(e));
+        readJoystickEvents(i);
 
-            if (errno == ENODEV)
-                _glfw.x11.joystick[i].present = GL_FALSE;
+        if (!_glfw.x11.joystick[i].present)
+            _glfw.x11.joystick[i].released = GL_TRUE;
+    }
+#endif // __linux__
+}
 
-            if (result == -1)
-                break;
+#ifdef __linux__
 
-            // We don't care if it's an init event or not
-            e.type &= ~JS_EVENT_INIT;
+// Opens the specified joystick device in the first free slot, unless it is
+// already open
+// Returns the slot of the joystick, or -1 if it was not opened
+//
+static int openJoystick(const char* path)
+{
+    int i, joy = -1;
+    GLboolean result;
+    char* device = getInputDevice(path);
 
-            switch (e.type)
-            {
-                case JS_EVENT_AXIS:
-                    _glfw.x11.joystick[i].axis[e.number] =
-                        (float) e.value / 32767.0f;
-
-                    // We need to change the sign for the Y axes, so that
-                    // positive = up/forward, according to the GLFW spec.
-                    if (e.number & 1)
-                    {
-                        _glfw.x11.joystick[i].axis[e.number] =
-                            -_glfw.x11.joystick[i].axis[e.number];
-                    }
-
-                    break;
-
-                case JS_EVENT_BUTTON:
-                    _glfw.x11.joystick[i].button[e.number] =
-                        e.value ? GLFW_PRESS : GLFW_RELEASE;
-                    break;
-
-                default:
-                    break;
-            }
+    // The event and joystick device files of a device are both present, but
+    // only the first one opened is used
+    for (i = 0;  i <= GLFW_JOYSTICK_LAST;  i++)
+    {
+        if (!_glfw.x11.joystick[i].path)
+        {
+            if (joy == -1)
+                joy = i;
+        }
+        else if (strcmp(_glfw.x11.joystick[i].path, path) == 0 ||
+                 strcmp(_glfw.x11.joystick[i].device, device) == 0)
+        {
+            free(device);
+            return -1;
         }
     }
-#endif // __linux__
+
+    free(device);
+
+    if (joy == -1)
+        return -1;
+
+    if (isDeviceName(strrchr(path, '/') + 1, "event"))
+        result = openEvdevDevice(joy, path);
+    else
+        result = openJoystickDevice(joy, path);
+
+    if (!result)
+        return -1;
+
+    if (_glfw.x11.joystickThread.running)
+    {
+        struct epoll_event event;
+
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u32 = joy;
+        epoll_ctl(_glfw.x11.joystickThread.epoll, EPOLL_CTL_ADD,
+                  _glfw.x11.joystick[joy].fd, &event);
+    }
+
+    return joy;
 }
 
+#endif // __linux__
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -173,46 +820,54 @@ static void pollJoystickEvents(void)
 int _glfwInitJoysticks(void)
 {
 #ifdef __linux__
-    int i, joy = 0;
-    regex_t regex;
+    int i;
     DIR* dir;
-    const char* dirs[] =
+
+    // Event devices are preferred over the joystick devices of the same device
+    const struct { const char* dir; const char* prefix; } sources[] =
     {
-        "/dev/input",
-        "/dev"
+        { "/dev/input", "event" },
+        { "/dev/input", "js" },
+        { "/dev", "js" }
     };
 
-    if (regcomp(&regex, "^js[0-9]\\+$", 0) != 0)
+    // Devices are only added to and removed from /dev/input at runtime
+    _glfw.x11.joystickWatch.inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_glfw.x11.joystickWatch.inotify != -1)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR, "X11: Failed to compile regex");
-        return GL_FALSE;
+        _glfw.x11.joystickWatch.watch =
+            inotify_add_watch(_glfw.x11.joystickWatch.inotify, "/dev/input",
+                              IN_CREATE | IN_ATTRIB | IN_DELETE);
+        if (_glfw.x11.joystickWatch.watch == -1)
+        {
+            close(_glfw.x11.joystickWatch.inotify);
+            _glfw.x11.joystickWatch.inotify = -1;
+        }
     }
 
-    for (i = 0;  i < sizeof(dirs) / sizeof(dirs[0]);  i++)
+    for (i = 0;  i < sizeof(sources) / sizeof(sources[0]);  i++)
     {
         struct dirent* entry;
 
-        dir = opendir(dirs[i]);
+        dir = opendir(sources[i].dir);
         if (!dir)
             continue;
 
         while ((entry = readdir(dir)))
         {
-            char path[20];
-            regmatch_t match;
+            char path[32];
 
-            if (regexec(&regex, entry->d_name, 1, &match, 0) != 0)
+            if (!isDeviceName(entry->d_name, sources[i].prefix))
                 continue;
 
-            snprintf(path, sizeof(path), "%s/%s", dirs[i], entry->d_name);
-            if (openJoystickDevice(joy, path))
-                joy++;
+            snprintf(path, sizeof(path), "%s/%s", sources[i].dir, entry->d_name);
+            openJoystick(path);
         }
 
         closedir(dir);
     }
-
-    regfree(&regex);
+#else
+    _glfw.x11.joystickWatch.inotify = -1;
 #endif // __linux__
 
     return GL_TRUE;
@@ -225,16 +880,76 @@ void _glfwTerminateJoysticks(void)
 #ifdef __linux__
     int i;
 
+    if (_glfw.x11.joystickThread.running)
+        stopJoystickThread();
+
     for (i = 0;  i <= GLFW_JOYSTICK_LAST;  i++)
     {
-        if (_glfw.x11.joystick[i].present)
+        if (_glfw.x11.joystick[i].path)
+            closeJoystickDevice(i);
+    }
+
+    if (_glfw.x11.joystickWatch.inotify != -1)
+        close(_glfw.x11.joystickWatch.inotify);
+#endif // __linux__
+}
+
+// Opens newly added joystick devices and closes lost ones, reporting each
+// change to the application
+//
+void _glfwDetectJoystickConnection(void)
+{
+#ifdef __linux__
+    int i;
+
+    if (_glfw.x11.joystickWatch.inotify != -1)
+    {
+        ssize_t size, offset = 0;
+        char buffer[4096]
+            __attribute__ ((aligned(__alignof__(struct inotify_event))));
+        GLboolean removed = GL_FALSE;
+
+        size = read(_glfw.x11.joystickWatch.inotify, buffer, sizeof(buffer));
+
+        while (size > offset)
         {
-            close(_glfw.x11.joystick[i].fd);
-            free(_glfw.x11.joystick[i].axis);
-            free(_glfw.x11.joystick[i].button);
-            free(_glfw.x11.joystick[i].name);
+            const struct inotify_event* e =
+                (const struct inotify_event*) (buffer + offset);
+
+            offset += sizeof(struct inotify_event) + e->len;
 
-            _glfw.x11.joystick[i].present = GL_FALSE;
+            if (!e->len || !isJoystickName(e->name))
+                continue;
+
+            if (e->mask & (IN_CREATE | IN_ATTRIB))
+            {
+                // The device node may be created before it can be opened, so
+                // another attempt is made when its permissions change
+                char path[32];
+                int joy;
+
+                snprintf(path, sizeof(path), "/dev/input/%s", e->name);
+
+                joy = openJoystick(path);
+                if (joy != -1)
+                    _glfwInputJoystickChange(joy, GLFW_CONNECTED);
+            }
+            else if (e->mask & IN_DELETE)
+                removed = GL_TRUE;
+        }
+
+        // Reading a lost device is what marks it as no longer present
+        if (removed)
+            pollJoystickEvents();
+    }
+
+    for (i = 0;  i <= GLFW_JOYSTICK_LAST;  i++)
+    {
+        if (_glfw.x11.joystick[i].released)
+        {
+            __sync_synchronize();
+            closeJoystickDevice(i);
+            _glfwInputJoystickChange(i, GLFW_DISCONNECTED);
         }
     }
 #endif // __linux__
@@ -247,9 +962,19 @@ void _glfwTerminateJoysticks(void)
 
 int _glfwPlatformGetJoystickParam(int joy, int param)
 {
+    GLboolean present;
+    unsigned int sequence;
+
     pollJoystickEvents();
 
-    if (!_glfw.x11.joystick[joy].present)
+    do
+    {
+        sequence = beginStateRead(joy);
+        present = _glfw.x11.joystick[joy].present;
+    }
+    while (!endStateRead(joy, sequence));
+
+    if (!present)
         return 0;
 
     switch (param)
@@ -273,17 +998,24 @@ int _glfwPlatformGetJoystickParam(int joy, int param)
 int _glfwPlatformGetJoystickAxes(int joy, float* axes, int numAxes)
 {
     int i;
+    unsigned int sequence;
 
     pollJoystickEvents();
 
-    if (!_glfw.x11.joystick[joy].present)
-        return 0;
-
     if (_glfw.x11.joystick[joy].numAxes < numAxes)
         numAxes = _glfw.x11.joystick[joy].numAxes;
 
-    for (i = 0;  i < numAxes;  i++)
-        axes[i] = _glfw.x11.joystick[joy].axis[i];
+    do
+    {
+        sequence = beginStateRead(joy);
+
+        if (!_glfw.x11.joystick[joy].present)
+            return 0;
+
+        for (i = 0;  i < numAxes;  i++)
+            axes[i] = _glfw.x11.joystick[joy].axis[i];
+    }
+    while (!endStateRead(joy, sequence));
 
     return numAxes;
 }
@@ -292,17 +1024,24 @@ int _glfwPlatformGetJoystickButtons(int joy, unsigned char* buttons,
                                     int numButtons)
 {
     int i;
+    unsigned int sequence;
 
     pollJoystickEvents();
 
-    if (!_glfw.x11.joystick[joy].present)
-        return 0;
-
     if (_glfw.x11.joystick[joy].numButtons < numButtons)
         numButtons = _glfw.x11.joystick[joy].numButtons;
 
-    for (i = 0;  i < numButtons;  i++)
-        buttons[i] = _glfw.x11.joystick[joy].button[i];
+    do
+    {
+        sequence = beginStateRead(joy);
+
+        if (!_glfw.x11.joystick[joy].present)
+            return 0;
+
+        for (i = 0;  i < numButtons;  i++)
+            buttons[i] = _glfw.x11.joystick[joy].button[i];
+    }
+    while (!endStateRead(joy, sequence));
 
     return numButtons;
 }
@@ -315,3 +1054,71 @@ const char* _glfwPlatformGetJoystickName(int joy)
     return _glfw.x11.joystick[joy].name;
 }
 
+int _glfwPlatformGetJoystickEvents(int joy, GLFWjoystickevent* events, int maxevents)
+{
+#ifdef __linux__
+    int i, count;
+    unsigned int first, written;
+
+    pollJoystickEvents();
+
+    if (!_glfw.x11.joystick[joy].events)
+        return 0;
+
+    written = _glfw.x11.joystick[joy].eventsWritten;
+    __sync_synchronize();
+
+    // Skip events that have already been overwritten
+    first = _glfw.x11.joystick[joy].eventsRead;
+    if (written - first > _GLFW_JOYSTICK_EVENT_COUNT)
+        first = written - _GLFW_JOYSTICK_EVENT_COUNT;
+
+    count = (int) (written - first);
+    if (count > maxevents)
+        count = maxevents;
+
+    for (i = 0;  i < count;  i++)
+    {
+        events[i] = _glfw.x11.joystick[joy].events[(first + i) %
+                                                   _GLFW_JOYSTICK_EVENT_COUNT];
+    }
+
+    // The joystick thread may have overwritten the oldest copied events while
+    // they were being copied, in which case they are dropped
+    __sync_synchronize();
+    written = _glfw.x11.joystick[joy].eventsWritten;
+    if (written - first >= _GLFW_JOYSTICK_EVENT_COUNT)
+    {
+        const int lost = (int) (written - first - _GLFW_JOYSTICK_EVENT_COUNT) + 1;
+
+        if (lost >= count)
+            count = 0;
+        else
+        {
+            memmove(events, events + lost, sizeof(GLFWjoystickevent) * (count - lost));
+            count -= lost;
+        }
+
+        first += lost;
+    }
+
+    _glfw.x11.joystick[joy].eventsRead = first + count;
+    return count;
+#else
+    return 0;
+#endif // __linux__
+}
+
+void _glfwPlatformSetJoystickThread(int enabled)
+{
+#ifdef __linux__
+    if (enabled == _glfw.x11.joystickThread.running)
+        return;
+
+    if (enabled)
+        startJoystickThread();
+    else
+        stopJoystickThread();
+#endif // __linux__
+}
+
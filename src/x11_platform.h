@@ -34,7 +34,9 @@
 #include <unistd.h>
 #include <signal.h>
 #include <stdint.h>
+#include <pthread.h>
 #include <X11/Xlib.h>
+#include <X11/Xutil.h>
 #include <X11/keysym.h>
 #include <X11/Xatom.h>
 
@@ -47,6 +49,21 @@
 // The Xkb extension provides improved keyboard support
 #include <X11/XKBlib.h>
 
+// The evdev interface provides joystick input with axis ranges and timestamps
+#if defined(__linux__)
+ #include <linux/input.h>
+#endif
+
+// The XInput2 extension provides raw mouse motion for captured cursor mode
+#if defined(_GLFW_HAS_XINPUT)
+ #include <X11/extensions/XInput2.h>
+#endif
+
+// The Present extension provides presentation timing of buffer swaps
+#if defined(_GLFW_HAS_XPRESENT)
+ #include <X11/extensions/Xpresent.h>
+#endif
+
 #if defined(_GLFW_GLX)
  #define _GLFW_X11_CONTEXT_VISUAL window->glx.visual
  #include "glx_platform.h"
@@ -69,6 +86,24 @@
 #define _GLFW_CLIPBOARD_FORMAT_STRING   2
 #define _GLFW_CLIPBOARD_FORMAT_COUNT    3
 
+// Number of entries in the key code and modifier to character cache
+#define _GLFW_CHAR_CACHE_SIZE           256
+
+// Largest property written at once, to let receivers stream large strings
+#define _GLFW_SELECTION_CHUNK_SIZE      262144
+
+// Maximum number of simultaneous incremental selection transfers
+#define _GLFW_SELECTION_TRANSFER_COUNT  8
+
+// Number of timestamped events kept for each joystick
+#define _GLFW_JOYSTICK_EVENT_COUNT      1024
+
+// Initial estimate of how late a sleeping thread is woken up, in seconds
+#define _GLFW_SLEEP_LATENCY             0.0005
+
+// Number of joystick device events read with a single system call
+#define _GLFW_JOYSTICK_READ_COUNT       64
+
 
 //========================================================================
 // GLFW platform specific types
@@ -88,17 +123,55 @@ typedef struct _GLFWwindowX11
     // Platform specific window resources
     Colormap        colormap;          // Window colormap
     Window          handle;            // Window handle
+    Window          parent;            // Parent window, usually a WM frame
+
+    // Window geometry, kept up to date from ConfigureNotify events
+    int             xpos, ypos;
+    int             width, height;
 
     // Various platform specific internal variables
     GLboolean       overrideRedirect; // True if window is OverrideRedirect
     GLboolean       cursorGrabbed;    // True if cursor is currently grabbed
     GLboolean       cursorHidden;     // True if cursor is currently hidden
     GLboolean       cursorCentered;   // True if cursor was moved since last poll
+    GLboolean       rawMotion;        // True if raw motion events are selected
     int             cursorPosX, cursorPosY;
 
+    // Sub-pixel remainders of raw motion deltas not yet reported
+    double          rawRemainderX, rawRemainderY;
+
+    // Number of buffer swaps reported as presented by the Present extension
+    uint64_t        presentCount;
+
+    // Pending asynchronous clipboard request
+    struct {
+        GLFWclipboardfun callback;
+        GLFWclipboardstreamfun stream;
+        int         format;           // Index of the format being converted
+        GLboolean   incremental;      // True if receiving in chunks (INCR)
+        Window      owner;            // Selection owner when requested
+        uint64_t    deadline;         // Timer value of failure, zero for never
+        char*       data;             // Data received so far, unless streaming
+        size_t      length;
+    } clipboard;
+
 } _GLFWwindowX11;
 
 
+//------------------------------------------------------------------------
+// Incremental (INCR) selection transfer to another client
+//------------------------------------------------------------------------
+typedef struct _GLFWtransferX11
+{
+    Window          requestor;
+    Atom            property;
+    Atom            target;
+    size_t          offset;           // Bytes of the string sent so far
+    size_t          length;
+
+} _GLFWtransferX11;
+
+
 //------------------------------------------------------------------------
 // Platform-specific library global data for X11
 //------------------------------------------------------------------------
@@ -108,12 +181,20 @@ typedef struct _GLFWlibraryX11
     int             screen;
     Window          root;
 
+    // Context for mapping window XIDs to _GLFWwindow pointers
+    XContext        context;
+
     // Invisible cursor for hidden cursor mode
     Cursor          cursor;
 
+    // Self-pipe used by glfwPostEmptyEvent to wake up glfwWaitEvents
+    int             emptyEventPipe[2];
+
     // Window manager atoms
     Atom            WM_STATE;
     Atom            WM_DELETE_WINDOW;
+    Atom            NET_SUPPORTING_WM_CHECK;
+    Atom            NET_SUPPORTED;
     Atom            NET_WM_NAME;
     Atom            NET_WM_ICON_NAME;
     Atom            NET_WM_PING;
@@ -126,6 +207,7 @@ typedef struct _GLFWlibraryX11
     Atom            CLIPBOARD;
     Atom            UTF8_STRING;
     Atom            COMPOUND_STRING;
+    Atom            INCR;
 
     // True if window manager supports EWMH
     GLboolean       hasEWMH;
@@ -153,9 +235,38 @@ typedef struct _GLFWlibraryX11
         int         versionMinor;
     } xkb;
 
+    struct {
+        GLboolean   available;
+        int         majorOpcode;
+        int         eventBase;
+        int         errorBase;
+        int         versionMajor;
+        int         versionMinor;
+        // Number of windows using the shared root window raw motion selection
+        int         rawMotionCount;
+    } xi;
+
+    struct {
+        GLboolean   available;
+        int         majorOpcode;
+        int         eventBase;
+        int         errorBase;
+        int         versionMajor;
+        int         versionMinor;
+    } present;
+
     // LUT for mapping X11 key codes to GLFW key codes
     int             keyCodeLUT[256];
 
+    // GLFW key codes of the keys identified by their XKB key names
+    int             keyNameLUT[256];
+
+    // Cache of Unicode code points by key code and modifier state
+    struct {
+        unsigned int key;             // Key code, state and valid bit
+        int         codepoint;
+    } charCache[_GLFW_CHAR_CACHE_SIZE];
+
     struct {
         GLboolean   changed;
         int         timeout;
@@ -166,26 +277,71 @@ typedef struct _GLFWlibraryX11
 
     struct {
         GLboolean   monotonic;
+        uint64_t    frequency;
         double      resolution;
         uint64_t    base;
+        // Average oversleep, in timer units, shared by all waiting threads
+        // It is 32-bit so that it can be updated atomically on every target
+        unsigned int sleepLatency;
+        GLboolean   serverSynced;
+        double      serverOffset;
+        Time        serverLast;
+        GLboolean   joystickSynced;
+        double      joystickOffset;
+        unsigned long joystickLast;
     } timer;
 
     struct {
         Atom        formats[_GLFW_CLIPBOARD_FORMAT_COUNT];
         char*       string;
         Atom        property;
+        size_t      chunkSize;        // Largest property sent in one piece
+        _GLFWtransferX11 transfers[_GLFW_SELECTION_TRANSFER_COUNT];
     } selection;
 
     struct {
+        volatile unsigned int sequence; // Odd while the state is being changed
         int         present;
+        volatile int released;        // True once a lost device is no longer read
         int         fd;
+        char*       path;             // Device path, or NULL if the slot is free
+        char*       device;           // Input device shared by its device files
         int         numAxes;
         int         numButtons;
         float*      axis;
         unsigned char* button;
         char*       name;
+
+        // Ring buffer of timestamped events, indexed by the running counts
+        // of events written and read modulo its size
+        GLFWjoystickevent* events;
+        volatile unsigned int eventsWritten;
+        unsigned int eventsRead;
+
+#if defined(__linux__)
+        // Event device state, used instead of the joystick device if possible
+        GLboolean   evdev;
+        GLboolean   dropped;          // True while skipping to the next report
+        unsigned short keyMap[KEY_CNT]; // Button index plus one, by key code
+        unsigned char absMap[ABS_CNT];  // Axis index plus one, by axis code
+        struct input_absinfo absInfo[ABS_CNT];
+#endif
     } joystick[GLFW_JOYSTICK_LAST + 1];
 
+    // Background thread reading joystick events as they arrive
+    struct {
+        GLboolean   running;
+        pthread_t   thread;
+        int         epoll;
+        int         stop;             // Event file signaled to stop the thread
+    } joystickThread;
+
+    // Watch for joystick devices being added to or removed from /dev/input
+    struct {
+        int         inotify;
+        int         watch;
+    } joystickWatch;
+
 } _GLFWlibraryX11;
 
 
@@ -205,8 +361,15 @@ typedef struct _GLFWmonitorX11
 // Prototypes for platform specific internal functions
 //========================================================================
 
+// Keyboard mapping
+void _glfwUpdateKeyCodeLUT(void);
+void _glfwUpdateKeyCodeRange(int first, int count);
+
 // Time
 void _glfwInitTimer(void);
+double _glfwTranslateServerTime(Time time);
+double _glfwTranslateJoystickTime(unsigned int time);
+double _glfwTranslateClockTime(long seconds, long microseconds);
 
 // Gamma
 void _glfwInitGammaRamp(void);
@@ -218,6 +381,8 @@ int _glfwCreateContext(_GLFWwindow* window,
                        const _GLFWwndconfig* wndconfig,
                        const _GLFWfbconfig* fbconfig);
 void _glfwDestroyContext(_GLFWwindow* window);
+GLboolean _glfwSelectSwapEvents(_GLFWwindow* window);
+GLboolean _glfwHandleSwapEvent(XEvent* event);
 
 // Fullscreen support
 void _glfwSetVideoMode(_GLFWmonitor* monitor, const GLFWvidmode* mode);
@@ -226,12 +391,19 @@ void _glfwRestoreVideoMode(_GLFWmonitor* monitor);
 // Joystick input
 int  _glfwInitJoysticks(void);
 void _glfwTerminateJoysticks(void);
+void _glfwDetectJoystickConnection(void);
 
 // Unicode support
+void _glfwInitUnicode(void);
 long _glfwKeySym2Unicode(KeySym keysym);
 
 // Clipboard handling
-Atom _glfwWriteSelection(XSelectionRequestEvent* request);
+void _glfwHandleSelectionRequest(XSelectionRequestEvent* request);
+GLboolean _glfwHandleSelectionTransfer(XEvent* event);
+void _glfwHandleSelectionNotify(_GLFWwindow* window, XSelectionEvent* event);
+void _glfwHandleSelectionChunk(_GLFWwindow* window, XPropertyEvent* event);
+void _glfwCheckClipboardRequests(void);
+uint64_t _glfwGetClipboardDeadline(void);
 
 // Window support
 _GLFWwindow* _glfwFindWindowByHandle(Window handle);
@@ -30,6 +30,7 @@
 
 #include "internal.h"
 
+#include <limits.h>
 #include <sys/time.h>
 #include <time.h>
 
@@ -66,17 +67,119 @@ void _glfwInitTimer(void)
     if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
     {
         _glfw.x11.timer.monotonic = GL_TRUE;
-        _glfw.x11.timer.resolution = 1e-9;
+        _glfw.x11.timer.frequency = 1000000000;
     }
     else
 #endif
     {
-        _glfw.x11.timer.resolution = 1e-6;
+        _glfw.x11.timer.frequency = 1000000;
     }
 
+    _glfw.x11.timer.resolution = 1.0 / (double) _glfw.x11.timer.frequency;
+    _glfw.x11.timer.sleepLatency =
+        (unsigned int) (_GLFW_SLEEP_LATENCY * (double) _glfw.x11.timer.frequency);
+
     _glfw.x11.timer.base = getRawTime();
 }
 
+// Translate a millisecond timestamp from an unknown epoch to the GLFW time
+// base, using and updating the specified offset estimate
+//
+static double translateMillisecondTime(unsigned long time,
+                                       GLboolean* synced,
+                                       double* offset,
+                                       unsigned long* last)
+{
+    // The clock may be on another machine or have an unknown epoch, so the
+    // offset to the local clock is estimated as the smallest difference
+    // observed so far, i.e. that of the event delivered with the least latency
+    const double local = (double) getRawTime() * _glfw.x11.timer.resolution;
+    const double current = local - (double) time / 1000.0;
+
+    // Start over if the time went backwards, which happens when a 32-bit
+    // millisecond counter wraps around after about 49.7 days
+    if (!*synced || time < *last || current < *offset)
+    {
+        *offset = current;
+        *synced = GL_TRUE;
+    }
+
+    *last = time;
+
+    return *offset + (double) time / 1000.0 -
+           (double) _glfw.x11.timer.base * _glfw.x11.timer.resolution;
+}
+
+// Sleeps until the specified raw time or until interrupted
+//
+static void sleepUntil(uint64_t target)
+{
+#if defined(CLOCK_MONOTONIC)
+    if (_glfw.x11.timer.monotonic)
+    {
+        struct timespec ts;
+
+        ts.tv_sec = (time_t) (target / 1000000000);
+        ts.tv_nsec = (long) (target % 1000000000);
+
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+    else
+#endif
+    {
+        // The fallback clock is the wall clock, which has no absolute sleep
+        const uint64_t now = getRawTime();
+
+        if (target > now)
+        {
+            struct timespec ts;
+
+            ts.tv_sec = (time_t) ((target - now) / 1000000);
+            ts.tv_nsec = (long) ((target - now) % 1000000) * 1000;
+
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+// Translate an X server timestamp to the GLFW time base
+//
+double _glfwTranslateServerTime(Time time)
+{
+    return translateMillisecondTime(time,
+                                    &_glfw.x11.timer.serverSynced,
+                                    &_glfw.x11.timer.serverOffset,
+                                    &_glfw.x11.timer.serverLast);
+}
+
+// Translate a joystick event timestamp to the GLFW time base
+//
+double _glfwTranslateJoystickTime(unsigned int time)
+{
+    return translateMillisecondTime(time,
+                                    &_glfw.x11.timer.joystickSynced,
+                                    &_glfw.x11.timer.joystickOffset,
+                                    &_glfw.x11.timer.joystickLast);
+}
+
+// Translate a timestamp of the clock used by the timer to the GLFW time base
+//
+double _glfwTranslateClockTime(long seconds, long microseconds)
+{
+    uint64_t raw;
+
+    if (_glfw.x11.timer.monotonic)
+    {
+        raw = (uint64_t) seconds * (uint64_t) 1000000000 +
+              (uint64_t) microseconds * (uint64_t) 1000;
+    }
+    else
+        raw = (uint64_t) seconds * (uint64_t) 1000000 + (uint64_t) microseconds;
+
+    return (double) (int64_t) (raw - _glfw.x11.timer.base) *
+        _glfw.x11.timer.resolution;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -91,6 +194,68 @@ double _glfwPlatformGetTime(void)
 void _glfwPlatformSetTime(double time)
 {
     _glfw.x11.timer.base = getRawTime() -
-        (uint64_t) (time / _glfw.x11.timer.resolution);
+        (uint64_t) (time * (double) _glfw.x11.timer.frequency);
+}
+
+uint64_t _glfwPlatformGetTimerValue(void)
+{
+    return getRawTime();
+}
+
+uint64_t _glfwPlatformGetTimerFrequency(void)
+{
+    return _glfw.x11.timer.frequency;
+}
+
+void _glfwPlatformWaitUntil(double time)
+{
+    uint64_t deadline, now;
+
+    if (time * (double) _glfw.x11.timer.frequency <= 0.0)
+        return;
+
+    deadline = _glfw.x11.timer.base +
+               (uint64_t) (time * (double) _glfw.x11.timer.frequency);
+
+    for (;;)
+    {
+        // Other threads may be updating the estimate at the same time
+        const unsigned int latency =
+            __sync_fetch_and_add(&_glfw.x11.timer.sleepLatency, 0);
+        uint64_t target;
+
+        now = getRawTime();
+        if (now >= deadline)
+            return;
+
+        // Leave twice the average oversleep to the active wait
+        if (deadline - now <= (uint64_t) latency * 2)
+            break;
+
+        target = deadline - (uint64_t) latency * 2;
+        sleepUntil(target);
+
+        // Only uninterrupted sleeps that woke late say anything about latency
+        now = getRawTime();
+        if (now >= target)
+        {
+            uint64_t late = now - target;
+
+            // Wakeups later than any sane latency say nothing about the
+            // next sleep and would overflow the estimate
+            if (late > UINT_MAX / 2)
+                late = UINT_MAX / 2;
+
+            // A concurrent update wins over this one, which is harmless for
+            // an estimate
+            __sync_bool_compare_and_swap(&_glfw.x11.timer.sleepLatency,
+                                         latency,
+                                         latency - latency / 8 +
+                                         (unsigned int) (late / 8));
+        }
+    }
+
+    while (getRawTime() < deadline)
+        ;
 }
 
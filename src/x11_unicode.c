@@ -42,9 +42,10 @@
  * (UCS, Unicode) values.
  *
  * The array keysymtab[] contains pairs of X11 keysym values for graphical
- * characters and the corresponding Unicode value. The function
- * _glfwKeySym2Unicode() maps a keysym onto a Unicode value using a binary
- * search, therefore keysymtab[] must remain SORTED by keysym value.
+ * characters and the corresponding Unicode value. At initialization it is
+ * expanded by _glfwInitUnicode() into a two-level table indexed directly by
+ * the high and low bytes of the keysym, which _glfwKeySym2Unicode() then
+ * uses for constant time lookups.
  *
  * We allow to represent any UCS character in the range U-00000000 to
  * U-00FFFFFF by a keysym value in the range 0x01000000 to 0x01ffffff.
@@ -851,17 +852,52 @@ static struct codepair {
 };
 
 
+// Maximum number of 256-keysym pages used by keysymtab[]
+#define KEYSYM_PAGE_COUNT 32
+
+// Index + 1 of the page for each high keysym byte, or zero if there is none
+static unsigned char keysymPageIndex[256];
+
+// Unicode values of the keysyms on each page, or zero if there is none
+static unsigned short keysymPages[KEYSYM_PAGE_COUNT][256];
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Build the keysym to Unicode lookup table
+//
+void _glfwInitUnicode(void)
+{
+    int i, pageCount = 0;
+    const int count = sizeof(keysymtab) / sizeof(struct codepair);
+
+    if (keysymPageIndex[keysymtab[0].keysym >> 8])
+        return;
+
+    for (i = 0;  i < count;  i++)
+    {
+        const unsigned int high = keysymtab[i].keysym >> 8;
+        const unsigned int low = keysymtab[i].keysym & 0xff;
+
+        if (!keysymPageIndex[high])
+        {
+            if (pageCount == KEYSYM_PAGE_COUNT)
+                continue;
+
+            keysymPageIndex[high] = ++pageCount;
+        }
+
+        keysymPages[keysymPageIndex[high] - 1][low] = keysymtab[i].ucs;
+    }
+}
+
 // Convert X11 KeySym to Unicode
 //
 long _glfwKeySym2Unicode( KeySym keysym )
 {
-    int min = 0;
-    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
-    int mid;
+    unsigned int page;
 
     /* First check for Latin-1 characters (1:1 mapping) */
     if( (keysym >= 0x0020 && keysym <= 0x007e) ||
@@ -873,20 +909,13 @@ long _glfwKeySym2Unicode( KeySym keysym )
     if( (keysym & 0xff000000) == 0x01000000 )
         return keysym & 0x00ffffff;
 
-    /* Binary search in table */
-    while( max >= min )
-    {
-        mid = (min + max) / 2;
-        if( keysymtab[mid].keysym < keysym )
-            min = mid + 1;
-        else if( keysymtab[mid].keysym > keysym )
-            max = mid - 1;
-        else
-        {
-            /* Found it! */
-            return keysymtab[mid].ucs;
-        }
-    }
+    /* Look up the page, then the character within it */
+    if( keysym > 0xffff )
+        return -1;
+
+    page = keysymPageIndex[keysym >> 8];
+    if( page && keysymPages[page - 1][keysym & 0xff] )
+        return keysymPages[page - 1][keysym & 0xff];
 
     /* No matching Unicode value found */
     return -1;
@@ -32,6 +32,7 @@
 
 #include <sys/select.h>
 
+#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -51,7 +52,7 @@
 //
 static int translateKey(int keycode)
 {
-    // Use the pre-filled LUT (see updateKeyCodeLUT() in x11_init.c)
+    // Use the pre-filled LUT (see _glfwUpdateKeyCodeLUT() in x11_init.c)
     if ((keycode >= 0) && (keycode < 256))
         return _glfw.x11.keyCodeLUT[keycode];
     else
@@ -63,12 +64,25 @@ static int translateKey(int keycode)
 static int translateChar(XKeyEvent* event)
 {
     KeySym keysym;
+    unsigned int key, slot;
+
+    // Only the modifiers and the Xkb group affect the keysym, not the buttons
+    const unsigned int state = event->state & (0xff | (3 << 13));
+
+    key = 0x80000000 | (state << 8) | (event->keycode & 0xff);
+    slot = (event->keycode ^ (state * 37)) % _GLFW_CHAR_CACHE_SIZE;
+
+    if (_glfw.x11.charCache[slot].key == key)
+        return _glfw.x11.charCache[slot].codepoint;
 
     // Get X11 keysym
     XLookupString(event, NULL, 0, &keysym, NULL);
 
     // Convert to Unicode (see x11_unicode.c)
-    return (int) _glfwKeySym2Unicode(keysym);
+    _glfw.x11.charCache[slot].key = key;
+    _glfw.x11.charCache[slot].codepoint = (int) _glfwKeySym2Unicode(keysym);
+
+    return _glfw.x11.charCache[slot].codepoint;
 }
 
 // Create the X11 window (and its colormap)
@@ -129,8 +143,22 @@ static GLboolean createWindow(_GLFWwindow* window,
             _glfwInputError(GLFW_PLATFORM_ERROR, "X11: Failed to create window");
             return GL_FALSE;
         }
+
+        // The geometry is updated by the events that follow any changes
+        window->x11.parent = _glfw.x11.root;
+        window->x11.xpos = 0;
+        window->x11.ypos = 0;
+        window->x11.width = wndconfig->width;
+        window->x11.height = wndconfig->height;
     }
 
+    // Associate the GLFW window with the X11 window so that events can be
+    // dispatched without searching the window list
+    XSaveContext(_glfw.x11.display,
+                 window->x11.handle,
+                 _glfw.x11.context,
+                 (XPointer) window);
+
     if (window->monitor && !_glfw.x11.hasEWMH)
     {
         // This is the butcher's way of removing window decorations
@@ -218,13 +246,68 @@ static GLboolean createWindow(_GLFWwindow* window,
     XRRSelectInput(_glfw.x11.display, window->x11.handle,
                    RRScreenChangeNotifyMask);
 
+    // Swap completion events from the context API carry the swap count and
+    // are preferred over those of the Present extension
+    if (!_glfwSelectSwapEvents(window))
+    {
+#if defined(_GLFW_HAS_XPRESENT)
+        if (_glfw.x11.present.available)
+        {
+            XPresentSelectInput(_glfw.x11.display, window->x11.handle,
+                                PresentCompleteNotifyMask);
+        }
+#endif // _GLFW_HAS_XPRESENT
+    }
+
     return GL_TRUE;
 }
 
+// Select or deselect XInput2 raw motion events for the specified window
+//
+static void setRawMotion(_GLFWwindow* window, GLboolean enabled)
+{
+#if defined(_GLFW_HAS_XINPUT)
+    XIEventMask em;
+    unsigned char mask[XIMaskLen(XI_RawMotion)] = { 0 };
+
+    if (!_glfw.x11.xi.available || window->x11.rawMotion == enabled)
+        return;
+
+    window->x11.rawMotion = enabled;
+    window->x11.rawRemainderX = 0.0;
+    window->x11.rawRemainderY = 0.0;
+
+    // Raw events are only delivered to the root window, where the selection
+    // is shared by all windows of this client, so it only changes when the
+    // first window starts or the last one stops using it
+    if (enabled)
+    {
+        if (_glfw.x11.xi.rawMotionCount++ > 0)
+            return;
+    }
+    else
+    {
+        if (--_glfw.x11.xi.rawMotionCount > 0)
+            return;
+    }
+
+    em.deviceid = XIAllMasterDevices;
+    em.mask_len = sizeof(mask);
+    em.mask = mask;
+
+    if (enabled)
+        XISetMask(mask, XI_RawMotion);
+
+    XISelectEvents(_glfw.x11.display, _glfw.x11.root, &em, 1);
+#endif // _GLFW_HAS_XINPUT
+}
+
 // Hide cursor
 //
 static void hideCursor(_GLFWwindow* window)
 {
+    setRawMotion(window, GL_FALSE);
+
     // Un-grab cursor (in windowed mode only; in fullscreen mode we still
     // want the cursor grabbed in order to confine the cursor to the window
     // area)
@@ -259,12 +342,18 @@ static void captureCursor(_GLFWwindow* window)
             window->x11.cursorCentered = GL_FALSE;
         }
     }
+
+    // Use raw motion deltas instead of re-centering the cursor, if available
+    if (window->x11.cursorGrabbed)
+        setRawMotion(window, GL_TRUE);
 }
 
 // Show cursor
 //
 static void showCursor(_GLFWwindow* window)
 {
+    setRawMotion(window, GL_FALSE);
+
     // Un-grab cursor (in windowed mode only; in fullscreen mode we still
     // want the cursor grabbed in order to confine the cursor to the window
     // area)
@@ -421,21 +510,176 @@ _GLFWwindow* _glfwFindWindowByHandle(Window handle)
 {
     _GLFWwindow* window;
 
-    for (window = _glfw.windowListHead;  window;  window = window->next)
+    if (XFindContext(_glfw.x11.display,
+                     handle,
+                     _glfw.x11.context,
+                     (XPointer*) &window) != 0)
+    {
+        return NULL;
+    }
+
+    return window;
+}
+
+// Returns the time of the specified X event in the GLFW time base
+//
+static double getEventTime(const XEvent* event)
+{
+    Time time = CurrentTime;
+
+    switch (event->type)
+    {
+        case KeyPress:
+        case KeyRelease:
+            time = event->xkey.time;
+            break;
+        case ButtonPress:
+        case ButtonRelease:
+            time = event->xbutton.time;
+            break;
+        case MotionNotify:
+            time = event->xmotion.time;
+            break;
+        case EnterNotify:
+        case LeaveNotify:
+            time = event->xcrossing.time;
+            break;
+        case PropertyNotify:
+            time = event->xproperty.time;
+            break;
+    }
+
+    // Events without a server timestamp, including those sent by other
+    // clients, are considered to have happened when they were received
+    if (time == CurrentTime || event->xany.send_event)
+        return _glfwPlatformGetTime();
+
+    return _glfwTranslateServerTime(time);
+}
+
+#if defined(_GLFW_HAS_XINPUT)
+
+// Process the specified XInput2 raw motion event
+//
+static void processRawMotion(const XIRawEvent* event)
+{
+    int dx, dy;
+    const double* values = event->raw_values;
+    _GLFWwindow* window = _glfw.focusedWindow;
+
+    if (!window || !window->x11.rawMotion)
+        return;
+
+    _glfw.eventTime = _glfwTranslateServerTime(event->time);
+
+    // Raw values are only present for the valuators set in the mask
+    if (XIMaskIsSet(event->valuators.mask, 0))
+        window->x11.rawRemainderX += *values++;
+    if (XIMaskIsSet(event->valuators.mask, 1))
+        window->x11.rawRemainderY += *values++;
+
+    // Report whole units and keep the sub-pixel rest for the next event
+    dx = (int) window->x11.rawRemainderX;
+    dy = (int) window->x11.rawRemainderY;
+    window->x11.rawRemainderX -= dx;
+    window->x11.rawRemainderY -= dy;
+
+    _glfwInputCursorMotion(window, dx, dy);
+}
+
+#endif // _GLFW_HAS_XINPUT
+
+// Process the specified Xkb keyboard mapping event
+//
+static void processKeyboardEvent(XkbEvent* event)
+{
+    // Any cached character may now come from a different keysym
+    memset(_glfw.x11.charCache, 0, sizeof(_glfw.x11.charCache));
+
+    switch (event->any.xkb_type)
     {
-        if (window->x11.handle == handle)
-            return window;
+        case XkbNewKeyboardNotify:
+        {
+            // The key codes, their names and keysyms may all have changed
+            _glfwUpdateKeyCodeLUT();
+            break;
+        }
+
+        case XkbMapNotify:
+        {
+            // Only the keysyms of the reported key codes have changed
+            XkbRefreshKeyboardMapping(&event->map);
+
+            if (event->map.changed & XkbKeySymsMask)
+            {
+                _glfwUpdateKeyCodeRange(event->map.first_key_sym,
+                                        event->map.num_key_syms);
+            }
+
+            break;
+        }
     }
+}
 
-    return NULL;
+// Returns whether the ConfigureNotify event has the position of the window
+// relative to the root window
+//
+static GLboolean hasRootPosition(const _GLFWwindow* window, const XEvent* event)
+{
+    // Real events for a reparented window are relative to its frame, but the
+    // window manager sends synthetic ones in root coordinates (ICCCM 4.1.5)
+    return event->xany.send_event || window->x11.parent == _glfw.x11.root;
 }
 
+#if defined(_GLFW_HAS_XPRESENT)
+
+// Reports the presentation of a buffer swap completed by the Present extension
+//
+static void processPresentComplete(const XPresentCompleteNotifyEvent* event)
+{
+    _GLFWwindow* window;
+
+    // Only presentations of pixmaps, i.e. buffer swaps, are of interest
+    if (event->kind != PresentCompleteKindPixmap)
+        return;
+
+    window = _glfwFindWindowByHandle(event->window);
+    if (!window)
+        return;
+
+    window->x11.presentCount++;
+
+    // The UST is in microseconds of the monotonic clock
+    _glfwInputWindowPresent(window,
+                            window->x11.presentCount,
+                            event->msc,
+                            _glfwTranslateClockTime((long) (event->ust / 1000000),
+                                                    (long) (event->ust % 1000000)));
+}
+
+#endif // _GLFW_HAS_XPRESENT
+
 // Process the specified X event
 //
 static void processEvent(XEvent *event)
 {
     _GLFWwindow* window = NULL;
 
+    // Requests for incremental transfers arrive on windows of other clients
+    if (_glfwHandleSelectionTransfer(event))
+        return;
+
+    // Swap completion events name the drawable rather than the window
+    if (_glfwHandleSwapEvent(event))
+        return;
+
+    // Keyboard mapping changes are not tied to any window
+    if (event->type == _glfw.x11.xkb.eventBase + XkbEventCode)
+    {
+        processKeyboardEvent((XkbEvent*) event);
+        return;
+    }
+
     if (event->type != GenericEvent)
     {
         window = _glfwFindWindowByHandle(event->xany.window);
@@ -447,6 +691,8 @@ static void processEvent(XEvent *event)
         }
     }
 
+    _glfw.eventTime = getEventTime(event);
+
     switch (event->type)
     {
         case KeyPress:
@@ -539,6 +785,10 @@ static void processEvent(XEvent *event)
                     if (_glfw.focusedWindow != window)
                         break;
 
+                    // Motion is reported by raw motion events instead
+                    if (window->x11.rawMotion)
+                        break;
+
                     x = event->xmotion.x - window->x11.cursorPosX;
                     y = event->xmotion.y - window->x11.cursorPosY;
                 }
@@ -560,14 +810,42 @@ static void processEvent(XEvent *event)
 
         case ConfigureNotify:
         {
-            _glfwInputWindowSize(window,
-                                 event->xconfigure.width,
-                                 event->xconfigure.height);
+            window->x11.width = event->xconfigure.width;
+            window->x11.height = event->xconfigure.height;
+
+            if (hasRootPosition(window, event))
+            {
+                window->x11.xpos = event->xconfigure.x;
+                window->x11.ypos = event->xconfigure.y;
+            }
+
+            _glfwInputWindowSize(window, window->x11.width, window->x11.height);
+            _glfwInputWindowPos(window, window->x11.xpos, window->x11.ypos);
+            break;
+        }
+
+        case ReparentNotify:
+        {
+            window->x11.parent = event->xreparent.parent;
 
-            _glfwInputWindowPos(window,
-                                event->xconfigure.x,
-                                event->xconfigure.y);
+            if (window->x11.parent == _glfw.x11.root)
+            {
+                window->x11.xpos = event->xreparent.x;
+                window->x11.ypos = event->xreparent.y;
+            }
+            else
+            {
+                // The position is now relative to the frame, so look up the
+                // root position once instead of on every query
+                Window child;
+                XTranslateCoordinates(_glfw.x11.display,
+                                      window->x11.handle, _glfw.x11.root,
+                                      0, 0,
+                                      &window->x11.xpos, &window->x11.ypos,
+                                      &child);
+            }
 
+            _glfwInputWindowPos(window, window->x11.xpos, window->x11.ypos);
             break;
         }
 
@@ -639,6 +917,8 @@ static void processEvent(XEvent *event)
 
         case PropertyNotify:
         {
+            _glfwHandleSelectionChunk(window, &event->xproperty);
+
             if (event->xproperty.atom == _glfw.x11.WM_STATE &&
                 event->xproperty.state == PropertyNewValue)
             {
@@ -676,29 +956,47 @@ static void processEvent(XEvent *event)
         case SelectionRequest:
         {
             // The contents of the clipboard selection was requested
+            _glfwHandleSelectionRequest(&event->xselectionrequest);
+            break;
+        }
 
-            XSelectionRequestEvent* request = &event->xselectionrequest;
-
-            XEvent response;
-            memset(&response, 0, sizeof(response));
-
-            response.xselection.property = _glfwWriteSelection(request);
-            response.xselection.type = SelectionNotify;
-            response.xselection.display = request->display;
-            response.xselection.requestor = request->requestor;
-            response.xselection.selection = request->selection;
-            response.xselection.target = request->target;
-            response.xselection.time = request->time;
-
-            XSendEvent(_glfw.x11.display,
-                       request->requestor,
-                       False, 0, &response);
+        case SelectionNotify:
+        {
+            _glfwHandleSelectionNotify(window, &event->xselection);
             break;
         }
 
         case DestroyNotify:
             return;
 
+        case GenericEvent:
+        {
+#if defined(_GLFW_HAS_XINPUT)
+            if (event->xcookie.extension == _glfw.x11.xi.majorOpcode &&
+                XGetEventData(_glfw.x11.display, &event->xcookie))
+            {
+                if (event->xcookie.evtype == XI_RawMotion)
+                    processRawMotion((XIRawEvent*) event->xcookie.data);
+
+                XFreeEventData(_glfw.x11.display, &event->xcookie);
+            }
+#endif // _GLFW_HAS_XINPUT
+#if defined(_GLFW_HAS_XPRESENT)
+            if (event->xcookie.extension == _glfw.x11.present.majorOpcode &&
+                XGetEventData(_glfw.x11.display, &event->xcookie))
+            {
+                if (event->xcookie.evtype == PresentCompleteNotify)
+                {
+                    processPresentComplete((XPresentCompleteNotifyEvent*)
+                                           event->xcookie.data);
+                }
+
+                XFreeEventData(_glfw.x11.display, &event->xcookie);
+            }
+#endif // _GLFW_HAS_XPRESENT
+            break;
+        }
+
         default:
         {
             switch (event->type - _glfw.x11.randr.eventBase)
@@ -715,6 +1013,140 @@ static void processEvent(XEvent *event)
     }
 }
 
+// Drains the empty event pipe of any pending wake-up bytes
+//
+static void drainEmptyEvents(void)
+{
+    char dummy[64];
+
+    while (read(_glfw.x11.emptyEventPipe[0], dummy, sizeof(dummy)) > 0)
+        ;
+}
+
+// Waits until the X connection has data to read, an empty event has been
+// posted, a joystick device has been added or removed or the timeout is
+// reached
+// The timeout is updated with the time remaining, if any
+//
+static GLboolean waitForEvent(double* timeout)
+{
+    fd_set fds;
+    const int fd = ConnectionNumber(_glfw.x11.display);
+    const int emptyFd = _glfw.x11.emptyEventPipe[0];
+    const int joystickFd = _glfw.x11.joystickWatch.inotify;
+    int count = (fd > emptyFd ? fd : emptyFd) + 1;
+
+    if (joystickFd >= count)
+        count = joystickFd + 1;
+
+    for (;;)
+    {
+        int result, error;
+        double wait;
+        uint64_t deadline;
+
+        FD_ZERO(&fds);
+        FD_SET(fd, &fds);
+        FD_SET(emptyFd, &fds);
+
+        if (joystickFd != -1)
+            FD_SET(joystickFd, &fds);
+
+        // Wake up in time to fail asynchronous clipboard requests that time
+        // out, as nothing else will
+        wait = timeout ? *timeout : -1.0;
+        deadline = _glfwGetClipboardDeadline();
+        if (deadline)
+        {
+            const uint64_t now = _glfwPlatformGetTimerValue();
+            double remaining = 0.0;
+
+            if (deadline > now)
+            {
+                remaining = (double) (deadline - now) /
+                            (double) _glfwPlatformGetTimerFrequency();
+            }
+
+            if (wait < 0.0 || remaining < wait)
+                wait = remaining;
+        }
+
+        // select(1) is used instead of an X function like XNextEvent, as the
+        // wait inside those are guarded by the mutex protecting the display
+        // struct, locking out other threads from using X (including GLX)
+        if (wait >= 0.0)
+        {
+            const long seconds = (long) wait;
+            const long microseconds = (long) ((wait - seconds) * 1e6);
+            struct timeval tv = { seconds, microseconds };
+            const double base = _glfwPlatformGetTime();
+
+            result = select(count, &fds, NULL, NULL, &tv);
+            error = errno;
+
+            if (timeout)
+                *timeout -= _glfwPlatformGetTime() - base;
+        }
+        else
+        {
+            result = select(count, &fds, NULL, NULL, NULL);
+            error = errno;
+        }
+
+        if (result > 0)
+        {
+            if (FD_ISSET(emptyFd, &fds))
+                drainEmptyEvents();
+
+            return GL_TRUE;
+        }
+
+        // Only restart the wait if it was interrupted by a signal and there is
+        // time left to wait
+        if (result == 0 || error != EINTR)
+            return GL_FALSE;
+        if (timeout && *timeout <= 0.0)
+            return GL_FALSE;
+    }
+}
+
+// Checks whether the specified event is immediately followed by an event that
+// supersedes it, for windows that have requested event coalescing
+//
+static GLboolean isSupersededEvent(const XEvent* event)
+{
+    XEvent next;
+    _GLFWwindow* window;
+
+    if (event->type != MotionNotify && event->type != ConfigureNotify)
+        return GL_FALSE;
+
+    window = _glfwFindWindowByHandle(event->xany.window);
+    if (!window || !window->coalesceEvents)
+        return GL_FALSE;
+
+    // Captured cursor motion is reported relative to the last warp, so
+    // dropping an event would also drop its part of the accumulated offset
+    if (event->type == MotionNotify &&
+        window->cursorMode == GLFW_CURSOR_CAPTURED)
+    {
+        return GL_FALSE;
+    }
+
+    XPeekEvent(_glfw.x11.display, &next);
+
+    if (next.type != event->type || next.xany.window != event->xany.window)
+        return GL_FALSE;
+
+    // A window position must not be dropped in favor of a relative one
+    if (event->type == ConfigureNotify &&
+        hasRootPosition(window, event) && !hasRootPosition(window, &next))
+    {
+        return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -763,6 +1195,11 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
     if (!_glfwCreateContext(window, wndconfig, fbconfig))
         return GL_FALSE;
 
+    // Headless contexts are complete without an X window, as the context API
+    // has already created an offscreen drawable for them
+    if (wndconfig->headless)
+        return GL_TRUE;
+
     if (!createWindow(window, wndconfig))
         return GL_FALSE;
 
@@ -797,6 +1234,11 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
+    setRawMotion(window, GL_FALSE);
+
+    free(window->x11.clipboard.data);
+    window->x11.clipboard.data = NULL;
+
     if (window->monitor)
         leaveFullscreenMode(window);
 
@@ -804,6 +1246,7 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 
     if (window->x11.handle)
     {
+        XDeleteContext(_glfw.x11.display, window->x11.handle, _glfw.x11.context);
         XUnmapWindow(_glfw.x11.display, window->x11.handle);
         XDestroyWindow(_glfw.x11.display, window->x11.handle);
         window->x11.handle = (Window) 0;
@@ -853,16 +1296,10 @@ void _glfwPlatformSetWindowTitle(_GLFWwindow* window, const char* title)
 
 void _glfwPlatformGetWindowPos(_GLFWwindow* window, int* xpos, int* ypos)
 {
-    Window child;
-    int x, y;
-
-    XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
-                          0, 0, &x, &y, &child);
-
     if (xpos)
-        *xpos = x;
+        *xpos = window->x11.xpos;
     if (ypos)
-        *ypos = y;
+        *ypos = window->x11.ypos;
 }
 
 void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
@@ -872,13 +1309,10 @@ void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
 
 void _glfwPlatformGetWindowSize(_GLFWwindow* window, int* width, int* height)
 {
-    XWindowAttributes attribs;
-    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
-
     if (width)
-        *width = attribs.width;
+        *width = window->x11.width;
     if (height)
-        *height = attribs.height;
+        *height = window->x11.height;
 }
 
 void _glfwPlatformSetWindowSize(_GLFWwindow* window, int width, int height)
@@ -961,9 +1395,18 @@ void _glfwPlatformPollEvents(void)
     {
         XEvent event;
         XNextEvent(_glfw.x11.display, &event);
+
+        // The next event is already in the queue, so it can be peeked at
+        // without blocking
+        if (count && isSupersededEvent(&event))
+            continue;
+
         processEvent(&event);
     }
 
+    _glfwDetectJoystickConnection();
+    _glfwCheckClipboardRequests();
+
     // Check whether the cursor has moved inside an focused window that has
     // captured the cursor (because then it needs to be re-centered)
 
@@ -972,6 +1415,7 @@ void _glfwPlatformPollEvents(void)
     if (window)
     {
         if (window->cursorMode == GLFW_CURSOR_CAPTURED &&
+            !window->x11.rawMotion &&
             !window->x11.cursorCentered)
         {
             int width, height;
@@ -990,25 +1434,28 @@ void _glfwPlatformPollEvents(void)
 void _glfwPlatformWaitEvents(void)
 {
     if (!XPending(_glfw.x11.display))
-    {
-        int fd;
-        fd_set fds;
-
-        fd = ConnectionNumber(_glfw.x11.display);
+        waitForEvent(NULL);
 
-        FD_ZERO(&fds);
-        FD_SET(fd, &fds);
+    _glfwPlatformPollEvents();
+}
 
-        // select(1) is used instead of an X function like XNextEvent, as the
-        // wait inside those are guarded by the mutex protecting the display
-        // struct, locking out other threads from using X (including GLX)
-        if (select(fd + 1, &fds, NULL, NULL, NULL) < 0)
-            return;
-    }
+void _glfwPlatformWaitEventsTimeout(double timeout)
+{
+    if (!XPending(_glfw.x11.display))
+        waitForEvent(&timeout);
 
     _glfwPlatformPollEvents();
 }
 
+void _glfwPlatformPostEmptyEvent(void)
+{
+    // A single byte is enough to wake up the select in waitForEvent
+    // If the pipe is already full a wake-up is pending anyway
+    const char byte = 0;
+    while (write(_glfw.x11.emptyEventPipe[1], &byte, 1) < 0 && errno == EINTR)
+        ;
+}
+
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, int x, int y)
 {
     // Store the new position so it can be recognized later
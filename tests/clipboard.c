@@ -35,10 +35,13 @@
 #include "getopt.h"
 
 static GLboolean closed = GL_FALSE;
+static GLboolean async = GL_FALSE;
+static GLboolean stream = GL_FALSE;
+static int received = 0;
 
 static void usage(void)
 {
-    printf("Usage: clipboard [-h]\n");
+    printf("Usage: clipboard [-a] [-s] [-t TIMEOUT] [-h]\n");
 }
 
 static GLboolean control_is_down(GLFWwindow* window)
@@ -52,6 +55,40 @@ static void error_callback(int error, const char* description)
     fprintf(stderr, "Error: %s\n", description);
 }
 
+static void print_clipboard(const char* string)
+{
+    if (string)
+        printf("Clipboard contains \"%s\"\n", string);
+    else
+        printf("Clipboard does not contain a string\n");
+}
+
+static void clipboard_callback(GLFWwindow* window, const char* string)
+{
+    print_clipboard(string);
+}
+
+static void clipboard_stream_callback(GLFWwindow* window,
+                                      const char* data,
+                                      int length)
+{
+    if (!data)
+    {
+        printf("Clipboard does not contain a string\n");
+        received = 0;
+    }
+    else if (length)
+    {
+        printf("Received %i bytes\n", length);
+        received += length;
+    }
+    else
+    {
+        printf("Clipboard contains %i bytes\n", received);
+        received = 0;
+    }
+}
+
 static int window_close_callback(GLFWwindow* window)
 {
     closed = GL_TRUE;
@@ -72,13 +109,12 @@ static void key_callback(GLFWwindow* window, int key, int action)
         case GLFW_KEY_V:
             if (control_is_down(window))
             {
-                const char* string;
-
-                string = glfwGetClipboardString(window);
-                if (string)
-                    printf("Clipboard contains \"%s\"\n", string);
+                if (stream)
+                    glfwRequestClipboardStream(window, clipboard_stream_callback);
+                else if (async)
+                    glfwRequestClipboardString(window, clipboard_callback);
                 else
-                    printf("Clipboard does not contain a string\n");
+                    print_clipboard(glfwGetClipboardString(window));
             }
             break;
 
@@ -101,12 +137,25 @@ static void window_size_callback(GLFWwindow* window, int width, int height)
 int main(int argc, char** argv)
 {
     int ch;
+    double timeout = 0.0;
     GLFWwindow* window;
 
-    while ((ch = getopt(argc, argv, "h")) != -1)
+    while ((ch = getopt(argc, argv, "ast:h")) != -1)
     {
         switch (ch)
         {
+            case 'a':
+                async = GL_TRUE;
+                break;
+
+            case 's':
+                stream = GL_TRUE;
+                break;
+
+            case 't':
+                timeout = atof(optarg);
+                break;
+
             case 'h':
                 usage();
                 exit(EXIT_SUCCESS);
@@ -125,6 +174,8 @@ int main(int argc, char** argv)
         exit(EXIT_FAILURE);
     }
 
+    glfwSetClipboardTimeout(timeout);
+
     window = glfwCreateWindow(200, 200, "Clipboard Test", NULL, NULL);
     if (!window)
     {
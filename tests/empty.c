@@ -0,0 +1,115 @@
+//========================================================================
+// Empty event test
+// Copyright (c) Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test is intended to verify that posting of empty events from
+// a secondary thread results in glfwWaitEvents returning (on all platforms)
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#include <GL/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static volatile GLboolean running = GL_TRUE;
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int thread_main(void* data)
+{
+    struct timespec time;
+
+    while (running)
+    {
+        clock_gettime(CLOCK_REALTIME, &time);
+        time.tv_sec += 1;
+        thrd_sleep(&time, NULL);
+
+        glfwPostEmptyEvent();
+    }
+
+    return 0;
+}
+
+static float nrand(void)
+{
+    return (float) rand() / (float) RAND_MAX;
+}
+
+int main(void)
+{
+    int result;
+    thrd_t thread;
+    GLFWwindow* window;
+
+    srand((unsigned int) time(NULL));
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    window = glfwCreateWindow(640, 480, "Empty Event Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+
+    if (thrd_create(&thread, thread_main, NULL) != thrd_success)
+    {
+        fprintf(stderr, "Failed to create secondary thread\n");
+
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    while (running)
+    {
+        glClearColor(nrand(), nrand(), nrand(), 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glfwSwapBuffers(window);
+
+        glfwWaitEvents();
+
+        if (glfwGetWindowParam(window, GLFW_SHOULD_CLOSE))
+            running = GL_FALSE;
+    }
+
+    glfwHideWindow(window);
+    thrd_join(thread, &result);
+    glfwDestroyWindow(window);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
+
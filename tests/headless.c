@@ -0,0 +1,193 @@
+//========================================================================
+// Headless context test
+// Copyright (c) Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test creates two headless contexts sharing objects, renders to the
+// first one and reads the result back without ever showing a window
+//
+// Surfaceless contexts have no default framebuffer, so the test renders to a
+// framebuffer object for those instead
+//
+//========================================================================
+
+#include <GL/glfw3.h>
+#include <GL/glext.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WIDTH  64
+#define HEIGHT 64
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static GLFWwindow* create_headless(GLFWwindow* share)
+{
+    GLFWwindow* window;
+
+    glfwWindowHint(GLFW_HEADLESS, GL_TRUE);
+    window = glfwCreateWindow(WIDTH, HEIGHT, "Headless", NULL, share);
+    if (!window)
+        return NULL;
+
+    if (!glfwGetWindowParam(window, GLFW_HEADLESS))
+    {
+        fprintf(stderr, "Window reports not being headless\n");
+        glfwDestroyWindow(window);
+        return NULL;
+    }
+
+    return window;
+}
+
+// Binds a framebuffer object to render to if the current context has no
+// default framebuffer
+// Returns GL_FALSE if there is nothing to render to
+//
+static GLboolean bind_framebuffer(GLFWwindow* window)
+{
+    GLuint fbo, rbo;
+    PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+    PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus;
+    PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers;
+    PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer;
+    PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer;
+
+    // Without framebuffer objects, only the default framebuffer is available
+    if (glfwGetWindowParam(window, GLFW_CONTEXT_VERSION_MAJOR) < 3 &&
+        !glfwExtensionSupported("GL_ARB_framebuffer_object"))
+    {
+        return GL_TRUE;
+    }
+
+    glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)
+        glfwGetProcAddress("glGenFramebuffers");
+    glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)
+        glfwGetProcAddress("glBindFramebuffer");
+    glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)
+        glfwGetProcAddress("glCheckFramebufferStatus");
+    glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)
+        glfwGetProcAddress("glGenRenderbuffers");
+    glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)
+        glfwGetProcAddress("glBindRenderbuffer");
+    glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)
+        glfwGetProcAddress("glRenderbufferStorage");
+    glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)
+        glfwGetProcAddress("glFramebufferRenderbuffer");
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_UNDEFINED)
+        return GL_TRUE;
+
+    printf("Context has no default framebuffer, using a framebuffer object\n");
+
+    glGenRenderbuffers(1, &rbo);
+    glBindRenderbuffer(GL_RENDERBUFFER, rbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH, HEIGHT);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, rbo);
+
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+int main(void)
+{
+    GLuint texture;
+    GLubyte pixel[4] = { 255, 0, 0, 255 };
+    GLFWwindow* first;
+    GLFWwindow* second;
+    int result = EXIT_SUCCESS;
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    first = create_headless(NULL);
+    if (!first)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(first);
+
+    printf("Headless context version: %s\n", glGetString(GL_VERSION));
+
+    if (bind_framebuffer(first))
+    {
+        glClearColor(1.f, 0.f, 0.f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glFinish();
+
+        glReadPixels(WIDTH / 2, HEIGHT / 2, 1, 1,
+                     GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        if (pixel[0] == 255 && pixel[1] == 0 && pixel[2] == 0)
+            printf("Rendering: passed\n");
+        else
+        {
+            printf("Rendering: failed (read back %i %i %i)\n",
+                   pixel[0], pixel[1], pixel[2]);
+            result = EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        printf("Rendering: skipped (no framebuffer to render to)\n");
+    }
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    glFinish();
+
+    second = create_headless(first);
+    if (!second)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(second);
+
+    if (glIsTexture(texture))
+        printf("Sharing: passed\n");
+    else
+    {
+        printf("Sharing: failed\n");
+        result = EXIT_FAILURE;
+    }
+
+    glfwTerminate();
+    exit(result);
+}
+
@@ -61,6 +61,14 @@ static void window_size_callback(GLFWwindow* window, int width, int height)
     glViewport(0, 0, width, height);
 }
 
+static void joystick_callback(int joy, int event)
+{
+    if (event == GLFW_CONNECTED)
+        printf("Joystick %i was connected\n", joy + 1);
+    else if (event == GLFW_DISCONNECTED)
+        printf("Joystick %i was disconnected\n", joy + 1);
+}
+
 static void draw_joystick(Joystick* j, int x, int y, int width, int height)
 {
     int i;
@@ -199,6 +207,8 @@ int main(void)
     if (!glfwInit())
         exit(EXIT_FAILURE);
 
+    glfwSetJoystickCallback(joystick_callback);
+
     window = glfwCreateWindow(640, 480, "Joystick Test", NULL, NULL);
     if (!window)
     {